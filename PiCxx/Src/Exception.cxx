@@ -33,7 +33,7 @@ namespace Py
             ob_trace    = Object{" PiCxx trace{ "  + m_trace   + "},  Python trace: " } + Object{ p_trace };
         }
 
-        PyErr_Restore( charge(*ob_errtype), charge(*ob_message), charge(*ob_trace) ); // PyErr_Restore eats charge
+        PyErr_Restore( ob_errtype.release(), ob_message.release(), ob_trace.release() ); // PyErr_Restore eats charge
     }
 
 } // Py
@@ -7,5 +7,8 @@
 #include "Base/Config.h"
 #include "Base/Debug.h"
 #include "Base/Exception.hxx"
+#include "Base/Gil.hxx"
+#include "Base/ThreadPool.hxx"
 #include "Base/File.h"
+#include "Base/InterpreterPool.hxx"
 
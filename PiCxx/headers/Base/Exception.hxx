@@ -107,6 +107,8 @@ namespace Py
         : m_trace{trace}, m_message{ "PiCxx Exception:"+message }
         { }
 
+        const std::string& message() const { return m_message; }
+
         void set_or_modify_python_error_indicator()  const;
     };
 
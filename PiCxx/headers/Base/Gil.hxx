@@ -0,0 +1,111 @@
+#pragma once
+
+#include <type_traits>
+
+/*
+ Scoped guards for the GIL.
+
+ GilRelease lets other Python threads run while C++ gets on with something long that doesn't touch Python
+ (number crunching, blocking I/O), and takes the GIL back when it goes out of scope, exception or not:
+
+        double Mesh::smooth( int passes )
+        {
+            GilRelease unlocked;
+            return smooth_vertices( passes );       // no Object in here!
+        }
+
+ GilAcquire is the other way round: a thread that doesn't hold the GIL (one of ours, or code running inside
+ a GilRelease) takes it for the scope, to call into Python:
+
+        {
+            GilAcquire locked;
+            callback.call( progress );
+        }
+
+ That takes the main interpreter's GIL (PyGILState only knows that one). A thread working for a subinterpreter
+ says which, GilAcquire locked{ interp }, and gets a thread state of that interpreter for the scope:
+ a task that outlives its call records this_interpreter() when it is made.
+ (a thread already in interp, holding the GIL, just carries on; one holding another interpreter's mustn't ask)
+
+ A typed method can be registered with 'nogil' instead of writing a GilRelease into it (see FuncMapper).
+ */
+
+namespace Py
+{
+    // this thread's state if it holds the GIL, else nullptr
+    // (PyGILState_Check only knows the main interpreter's; before 3.12 the current state is the process's, not the thread's)
+    inline PyThreadState* this_thread_state()
+    {
+#if PY_VERSION_HEX >= 0x030D0000
+        PyThreadState* ts = PyThreadState_GetUnchecked();
+#else
+        PyThreadState* ts = _PyThreadState_UncheckedGet();
+#endif
+        return ts && ts->thread_id == PyThread_get_thread_ident() ? ts : nullptr;
+    }
+
+    class GilRelease
+    {
+    private:
+        PyThreadState* m_state;
+
+    public:
+        GilRelease() : m_state{ PyEval_SaveThread() } { }
+        ~GilRelease() { PyEval_RestoreThread( m_state ); }
+
+        GilRelease( const GilRelease& ) = delete;
+        void operator=( const GilRelease& ) = delete;
+    };
+
+    class GilAcquire
+    {
+    private:
+        PyGILState_STATE    m_state;
+        PyThreadState*      m_own{ nullptr };       // made for the scope, for a subinterpreter
+        bool                m_held{ false };        // ...or nothing to do: we're in it already
+
+    public:
+        GilAcquire() : m_state{ PyGILState_Ensure() } { }
+
+        explicit GilAcquire( PyInterpreterState* interp )
+        {
+            PyThreadState* current = this_thread_state();
+            if( current && current->interp == interp ) {
+                m_held = true;
+                return;
+            }
+            if( interp == PyInterpreterState_Main() ) {
+                m_state = PyGILState_Ensure();
+                return;
+            }
+            m_own = PyThreadState_New( interp );
+            PyEval_RestoreThread( m_own );
+        }
+
+        ~GilAcquire()
+        {
+            if( m_held )
+                return;
+            if( ! m_own ) {
+                PyGILState_Release( m_state );
+                return;
+            }
+            PyThreadState_Clear( m_own );
+            PyEval_ReleaseThread( m_own );
+            PyThreadState_Delete( m_own );
+        }
+
+        GilAcquire( const GilAcquire& ) = delete;
+        void operator=( const GilAcquire& ) = delete;
+    };
+
+    // a GilRelease if 'release', else nothing: for code that is a template on whether to let go of the GIL
+    struct GilKept { };
+
+    template< bool release >
+    using GilReleaseIf = typename std::conditional< release, GilRelease, GilKept >::type;
+
+    // marks a method to run without the GIL, see FuncMapper: register_method< &Final::smooth >( "smooth", nogil )
+    struct NoGil { };
+    constexpr NoGil nogil{};
+}
@@ -0,0 +1,551 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/*
+ InterpreterPool: scripts evaluated in parallel, each worker an interpreter of its own
+
+ run_file() and the rest of πcxx run in the one interpreter that Py_Initialize made, so two scripts
+ are never both running Python: they take turns at its GIL. A pool of N workers runs N at a time:
+
+        InterpreterPool pool{ 4, { "rules" } };           // with the GIL held, after Py_Initialize
+
+        std::future<std::string> a = pool.submit( "x = rules.score( 'a' )", "x" );
+        std::future<std::string> b = pool.submit_file( "rules/b.py", "verdict" );
+        ...
+        std::string verdict = b.get();                    // str( verdict ), or throws Py::Exception
+
+ Each script runs in fresh globals, with __builtins__ and the pool's modules (imported once per worker,
+ so a πcxx module's init runs in each), then 'expression' is evaluated in them. What comes back is
+ str() of its value ("" with no expression): only strings cross over, because a worker's objects
+ belong to another process. An error in the script arrives as an Exception from get(), its message
+ the Python one ("ZeroDivisionError: division by zero").
+
+ Each worker is a process, fork()ed from this one as the pool starts, so it inherits the inittab and
+ everything imported so far. A script goes over, and its result comes back, through a shared memory
+ buffer of 'buffer' bytes. A process that dies fails the script it had, and the pool carries on without it.
+ (Not subinterpreters with a GIL each: 3.12 imports only modules that declare a per-interpreter GIL there,
+ and πcxx's ExtModule doesn't. See ExtModule.hxx)
+
+ The pool pays for itself where threads of this interpreter can't: scripts that keep the CPU busy, on a
+ machine with a core per worker, and scripts that wait in calls that hold the GIL (8 workers run those
+ ~7.5x as fast as one after another, on one core: see bench_pool). A round trip costs ~20µs, so scripts
+ much shorter than that are better run here.
+
+ The pool is made and destroyed with the GIL held. As with os.fork(), it is best started before the
+ program starts threads of its own: a child has only the thread that forked it.
+ submit() and get() don't need the GIL; the destructor finishes whatever was submitted.
+ */
+
+namespace Py
+{
+    class InterpreterPool
+    {
+        struct Job
+        {
+            std::string                     name;           // for tracebacks: the file, or "<pool>"
+            std::string                     code;
+            std::string                     expression;
+            std::promise<std::string>       result;
+        };
+
+        std::vector<std::string>    m_modules;
+        size_t                      m_size;
+        size_t                      m_buffer;
+
+        std::mutex                  m_mutex;        // guards everything below
+        std::condition_variable     m_work;         // a job was queued, or stop
+        std::deque<Job>             m_jobs;
+        bool                        m_stop{ false };
+        size_t                      m_alive{ 0 };   // workers taking jobs
+
+        std::vector<std::thread>    m_threads;      // one to feed each process
+
+#ifndef _WIN32
+        // the shared memory between the pool and a worker process, then the buffer
+        struct Channel
+        {
+            enum State { starting, failed, idle, request, response, quit };
+
+            pthread_mutex_t     mutex;
+            pthread_cond_t      changed;
+            int                 state;
+            int                 ok;
+            size_t              code_size;
+            size_t              expression_size;
+            size_t              name_size;
+            size_t              out_size;
+            char                data[1];
+        };
+
+        struct Process
+        {
+            pid_t       pid;
+            Channel*    channel;
+        };
+
+        std::vector<Process>        m_processes;
+#endif
+
+    public:
+        // 0 workers means one per core
+        explicit InterpreterPool( size_t workers, std::vector<std::string> modules = {}, size_t buffer = 1 << 20 )
+        : m_modules{ std::move(modules) }
+        , m_size{ workers ? workers : std::max<size_t>( std::thread::hardware_concurrency(), 1 ) }
+        , m_buffer{ buffer }
+        {
+            std::string failure = start_processes();
+            if( ! failure.empty() )
+                THROW( "InterpreterPool: " + failure );
+        }
+
+        ~InterpreterPool()
+        {
+            GilRelease unlocked;
+            stop();
+        }
+
+        InterpreterPool( const InterpreterPool& ) = delete;
+        void operator=( const InterpreterPool& ) = delete;
+
+        size_t size() const { return m_size; }
+
+        // run 'code' on the next free worker, then evaluate 'expression': the future has str() of its value
+        std::future<std::string> submit( std::string code, std::string expression = "" )
+        {
+            return enqueue( Job{ "<pool>", std::move(code), std::move(expression), {} } );
+        }
+
+        // the same with the script in a file (read now, on the calling thread)
+        std::future<std::string> submit_file( const std::string& path, std::string expression = "" )
+        {
+            std::ifstream file{ path };
+            std::ostringstream code;
+            code << file.rdbuf();
+
+            Job job{ path, code.str(), std::move(expression), {} };
+            if( ! file ) {
+                std::future<std::string> result = job.result.get_future();
+                finish( job, false, "can't read " + path );
+                return result;
+            }
+            return enqueue( std::move(job) );
+        }
+
+    private:
+        std::future<std::string> enqueue( Job&& job )
+        {
+            std::future<std::string> result = job.result.get_future();
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                if( m_alive > 0 ) {
+                    m_jobs.push_back( std::move(job) );
+                    m_work.notify_one();
+                    return result;
+                }
+            }
+            finish( job, false, "no workers left" );
+            return result;
+        }
+
+        // the next job, or false once stopped and nothing is left
+        bool take( Job& job )
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_work.wait( lock, [this] { return m_stop || ! m_jobs.empty(); } );
+            if( m_jobs.empty() )
+                return false;
+            job = std::move( m_jobs.front() );
+            m_jobs.pop_front();
+            return true;
+        }
+
+        static void finish( Job& job, bool ok, const std::string& out )
+        {
+            if( ok )
+                job.result.set_value( out );
+            else
+                job.result.set_exception( std::make_exception_ptr( Exception{ TRACE, out } ) );
+        }
+
+        // a worker has gone: with none left, what is queued can't run
+        void lost()
+        {
+            std::deque<Job> orphans;
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                if( --m_alive == 0 )
+                    orphans.swap( m_jobs );
+            }
+            for( Job& job : orphans )
+                finish( job, false, "no workers left" );
+        }
+
+        // finish what is queued, then end the workers (without the GIL)
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_stop = true;
+            }
+            m_work.notify_all();
+            for( auto& t : m_threads )
+                t.join();
+            m_threads.clear();
+
+#ifndef _WIN32
+            for( Process& p : m_processes ) {
+                lock( p );
+                p.channel->state = Channel::quit;
+                pthread_cond_broadcast( &p.channel->changed );
+                pthread_mutex_unlock( &p.channel->mutex );
+                if( p.pid )
+                    waitpid( p.pid, nullptr, 0 );
+                munmap( p.channel, channel_bytes() );
+            }
+            m_processes.clear();
+#endif
+            m_stop = false;
+            m_alive = 0;
+        }
+
+#pragma mark Inside a worker process, with its GIL
+
+        // globals for the scripts to start from: __builtins__ and the modules. New reference, or nullptr with 'failure'
+        static PyObject* base_globals( const std::vector<std::string>& modules, std::string& failure )
+        {
+            PyObject* globals = PyDict_New();
+            if( globals )
+                PyDict_SetItemString( globals, "__builtins__", PyEval_GetBuiltins() );
+            for( const std::string& name : modules ) {
+                PyObject* module = globals ? PyImport_ImportModule( name.c_str() ) : nullptr;
+                if( ! module || PyDict_SetItemString( globals, name.c_str(), module ) < 0 ) {
+                    failure = "importing " + name + ": " + error_text();
+                    Py_XDECREF( module );
+                    Py_XDECREF( globals );
+                    return nullptr;
+                }
+                Py_DECREF( module );
+            }
+            return globals;
+        }
+
+        // run the job's code in a copy of 'base', then the expression: false with the error in 'out'
+        static bool evaluate( PyObject* base, const char* name, const char* code, const char* expression, std::string& out )
+        {
+            PyObject* globals = PyDict_Copy( base );
+            PyObject* compiled = globals ? Py_CompileString( code, name, Py_file_input ) : nullptr;
+            PyObject* result = compiled ? PyEval_EvalCode( compiled, globals, globals ) : nullptr;
+            Py_XDECREF( compiled );
+
+            if( result && *expression ) {
+                Py_DECREF( result );
+                result = PyRun_String( expression, Py_eval_input, globals, globals );
+                PyObject* str = result ? PyObject_Str( result ) : nullptr;
+                Py_ssize_t size;
+                const char* utf8 = str ? PyUnicode_AsUTF8AndSize( str, &size ) : nullptr;
+                if( utf8 )
+                    out.assign( utf8, size );
+                Py_XDECREF( str );
+                if( ! utf8 )
+                    Py_CLEAR( result );
+            }
+            bool ok = result != nullptr;
+            if( ! ok )
+                out = error_text();
+            Py_XDECREF( result );
+            Py_XDECREF( globals );
+            return ok;
+        }
+
+        // "ValueError: bad rule", clearing the error
+        static std::string error_text()
+        {
+            PyObject *type, *value, *trace;
+            PyErr_Fetch( &type, &value, &trace );
+            PyErr_NormalizeException( &type, &value, &trace );
+
+            std::string text = type ? reinterpret_cast<PyTypeObject*>( type )->tp_name : "unknown error";
+            PyObject* str = value ? PyObject_Str( value ) : nullptr;
+            const char* utf8 = str ? PyUnicode_AsUTF8( str ) : nullptr;
+            if( utf8 && *utf8 )
+                text += std::string{ ": " } + utf8;
+            Py_XDECREF( str );
+            PyErr_Clear();
+
+            Py_XDECREF( type );
+            Py_XDECREF( value );
+            Py_XDECREF( trace );
+            return text;
+        }
+
+#pragma mark Processes
+
+#ifdef _WIN32
+        std::string start_processes() { return "worker processes need fork()"; }
+#else
+        size_t channel_bytes() const { return offsetof( Channel, data ) + m_buffer; }
+
+        // fork m_size workers, wait for them to import the modules, then start a thread to feed each
+        std::string start_processes()
+        {
+            std::string failure;
+            for( size_t i=0; i < m_size && failure.empty(); i++ ) {
+                void* shared = mmap( nullptr, channel_bytes(), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+                if( shared == MAP_FAILED ) {
+                    failure = "couldn't map the shared buffer";
+                    break;
+                }
+                Channel* channel = static_cast<Channel*>( shared );
+                init_channel( channel );
+
+                PyOS_BeforeFork();
+                pid_t pid = fork();
+                if( pid == 0 ) {
+                    PyOS_AfterFork_Child();
+                    serve_process( channel );
+                }
+                PyOS_AfterFork_Parent();
+
+                if( pid < 0 ) {
+                    munmap( channel, channel_bytes() );
+                    failure = "couldn't fork a worker process";
+                    break;
+                }
+                m_processes.push_back( Process{ pid, channel } );
+            }
+
+            {
+                GilRelease unlocked;
+                for( Process& p : m_processes ) {
+                    if( ! failure.empty() )
+                        break;
+                    if( ! lock( p ) )
+                        failure = "a worker process died as it started";
+                    else {
+                        while( p.channel->state == Channel::starting )
+                            if( ! wait_on( p ) )
+                                break;
+                        if( p.channel->state == Channel::failed )
+                            failure.assign( p.channel->data, p.channel->out_size );
+                        else if( p.channel->state == Channel::starting )
+                            failure = "a worker process died as it started";
+                    }
+                    pthread_mutex_unlock( &p.channel->mutex );
+                }
+
+                if( ! failure.empty() ) {
+                    stop();
+                    return failure;
+                }
+            }
+
+            m_alive = m_processes.size();
+            for( Process& p : m_processes )
+                m_threads.emplace_back( [this, &p] { feed_process( p ); } );
+            return failure;
+        }
+
+        // the mutex is robust: a process that dies holding it (killed as it writes a result, say) hands it on
+        // as EOWNERDEAD, instead of leaving the other side blocked for good. macOS has no robust mutexes
+        static void init_channel( Channel* channel )
+        {
+            pthread_mutexattr_t mutex_attr;
+            pthread_mutexattr_init( &mutex_attr );
+            pthread_mutexattr_setpshared( &mutex_attr, PTHREAD_PROCESS_SHARED );
+#ifndef __APPLE__
+            pthread_mutexattr_setrobust( &mutex_attr, PTHREAD_MUTEX_ROBUST );
+#endif
+            pthread_mutex_init( &channel->mutex, &mutex_attr );
+            pthread_mutexattr_destroy( &mutex_attr );
+
+            pthread_condattr_t cond_attr;
+            pthread_condattr_init( &cond_attr );
+            pthread_condattr_setpshared( &cond_attr, PTHREAD_PROCESS_SHARED );
+            pthread_cond_init( &channel->changed, &cond_attr );
+            pthread_condattr_destroy( &cond_attr );
+
+            channel->state = Channel::starting;
+        }
+
+        // wait on the channel (its mutex held) for up to 'ms': false if the process has died, which reaps it
+        static bool wait_on( Process& p, long ms = 100 )
+        {
+            int rc = timed_wait( p.channel, ms );
+            if( rc == 0 )
+                return true;
+            if( ! survived( p, rc ) )
+                return false;
+            if( p.pid && waitpid( p.pid, nullptr, WNOHANG ) == p.pid )
+                p.pid = 0;
+            return p.pid != 0;
+        }
+
+        // 0, ETIMEDOUT, or EOWNERDEAD (the mutex held again either way)
+        static int timed_wait( Channel* channel, long ms )
+        {
+            timespec until;
+            clock_gettime( CLOCK_REALTIME, &until );
+            until.tv_nsec += ( ms % 1000 ) * 1000000;
+            until.tv_sec  += ms / 1000 + until.tv_nsec / 1000000000;
+            until.tv_nsec %= 1000000000;
+            return pthread_cond_timedwait( &channel->changed, &channel->mutex, &until );
+        }
+
+        // lock the channel from the pool's side: false if the process died holding it, which reaps it
+        static bool lock( Process& p ) { return survived( p, pthread_mutex_lock( &p.channel->mutex ) ); }
+
+        // lock the channel from the worker's side: false if the pool's process died holding it
+        static bool lock( Channel* c ) { return owner_lived( c, pthread_mutex_lock( &c->mutex ) ); }
+
+        static bool survived( Process& p, int rc )
+        {
+            if( owner_lived( p.channel, rc ) )
+                return true;
+            if( p.pid )
+                waitpid( p.pid, nullptr, 0 );               // it is already on its way out
+            p.pid = 0;
+            return false;
+        }
+
+        // after locking, or waiting on, the channel: false if the process on the other side died holding
+        // the mutex. It is ours now, usable again, but what the dead side left in the channel is not to be trusted
+        static bool owner_lived( Channel* c, int rc )
+        {
+            if( rc != EOWNERDEAD )
+                return true;
+#ifndef __APPLE__
+            pthread_mutex_consistent( &c->mutex );
+#endif
+            return false;
+        }
+
+        // the pool's thread for a worker process: hands it each job, waits for the result
+        void feed_process( Process& p )
+        {
+            Channel* c = p.channel;
+            Job job;
+            while( take( job ) ) {
+                size_t bytes = job.code.size() + job.expression.size() + job.name.size() + 3;
+                if( bytes > m_buffer ) {
+                    finish( job, false, "the script is " + std::to_string(bytes) + " bytes, more than the pool's buffer" );
+                    continue;
+                }
+
+                bool alive = lock( p );
+                if( alive ) {
+                    char* at = c->data;
+                    for( const std::string* s : { &job.code, &job.expression, &job.name } ) {
+                        std::memcpy( at, s->c_str(), s->size() + 1 );
+                        at += s->size() + 1;
+                    }
+                    c->code_size = job.code.size();
+                    c->expression_size = job.expression.size();
+                    c->name_size = job.name.size();
+                    c->state = Channel::request;
+                    pthread_cond_broadcast( &c->changed );
+                }
+
+                while( alive && c->state != Channel::response )
+                    alive = wait_on( p );
+
+                std::string out{ c->data, alive ? c->out_size : 0 };
+                bool ok = c->ok != 0;
+                c->state = Channel::idle;
+                pthread_mutex_unlock( &c->mutex );
+
+                if( ! alive ) {
+                    finish( job, false, "the worker process running it died" );
+                    lost();
+                    return;
+                }
+                finish( job, ok, out );
+            }
+        }
+
+        // the forked worker: import the modules, then run what the channel brings until told to quit
+        [[noreturn]] void serve_process( Channel* c )
+        {
+            pid_t parent = getppid();
+            std::string out;
+            PyObject* base = base_globals( m_modules, out );
+
+            bool parent_lived = lock( c );
+            while( parent_lived ) {
+                if( ! base || c->state == Channel::request ) {
+                    if( base ) {
+                        std::string code{ c->data, c->code_size };
+                        std::string expression{ c->data + c->code_size + 1, c->expression_size };
+                        std::string name{ c->data + c->code_size + c->expression_size + 2, c->name_size };
+                        pthread_mutex_unlock( &c->mutex );
+
+                        out.clear();
+                        c->ok = evaluate( base, name.c_str(), code.c_str(), expression.c_str(), out );
+                        flush_std_streams();
+                        if( out.size() > m_buffer ) {
+                            c->ok = false;
+                            out = "the result is " + std::to_string( out.size() ) + " bytes, more than the pool's buffer";
+                        }
+                        if( ! lock( c ) )
+                            break;
+                    }
+                    std::memcpy( c->data, out.data(), std::min( out.size(), m_buffer ) );
+                    c->out_size = std::min( out.size(), m_buffer );
+                    c->state = base ? Channel::response : Channel::failed;
+                    pthread_cond_broadcast( &c->changed );
+                    if( ! base )
+                        break;
+                }
+                else if( c->state == Channel::starting ) {
+                    c->state = Channel::idle;
+                    pthread_cond_broadcast( &c->changed );
+                }
+                else if( c->state == Channel::quit )
+                    break;
+                else {
+                    int rc = timed_wait( c, 1000 );
+                    if( ! owner_lived( c, rc ) || ( rc != 0 && getppid() != parent ) )
+                        break;
+                }
+            }
+            pthread_mutex_unlock( &c->mutex );
+
+            flush_std_streams();
+            _exit( 0 );
+        }
+
+        // (_exit doesn't flush sys.stdout, so what a script prints would be lost)
+        static void flush_std_streams()
+        {
+            for( const char* name : { "stdout", "stderr" } ) {
+                PyObject* stream = PySys_GetObject( name );       // borrowed
+                PyObject* done = stream ? PyObject_CallMethod( stream, "flush", nullptr ) : nullptr;
+                Py_XDECREF( done );
+            }
+            PyErr_Clear();
+        }
+#endif
+    };
+}
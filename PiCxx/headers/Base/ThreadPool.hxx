@@ -0,0 +1,204 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ A work-stealing thread pool: πcxx runs offloaded methods on it (see Offload.hxx), and C++ code may submit to it too.
+
+ Each worker has its own queue. A worker takes its newest task first (whatever it submitted itself is likely still in cache),
+ and when its queue is empty it steals the oldest task from another's, so a burst of work spreads over all the workers.
+ A task submitted from outside the pool goes to the workers' queues in turn.
+
+ Nothing here knows about Python: a task that needs the GIL takes it (GilAcquire).
+ A task must not throw: as with std::thread, that ends in std::terminate.
+
+ The workers are started by the first submit(), and there is one pool for the process (shared()), sized by
+ set_size() before that: ExtModule does so from Final::thread_pool_size. shared() is a function-local static, so at
+ exit its destructor runs what is still queued and joins the workers. By then Py_Finalize has usually been and gone,
+ and a task that takes the GIL would find no interpreter: a program that offloads calls wait_idle() before Py_Finalize.
+ */
+
+namespace Py
+{
+    class ThreadPool
+    {
+    public:
+        using Task = std::function< void() >;
+
+    private:
+        struct Queue
+        {
+            std::mutex          mutex;
+            std::deque<Task>    tasks;
+        };
+
+        std::vector< std::unique_ptr<Queue> >   m_queues;
+        std::vector< std::thread >              m_threads;
+        size_t                                  m_size;
+
+        std::mutex                  m_mutex;        // guards the counts below, and starting / stopping
+        std::condition_variable     m_work;         // a task was queued, or stop
+        std::condition_variable     m_idle;         // nothing pending
+        size_t                      m_queued{ 0 };  // in a queue
+        size_t                      m_pending{ 0 }; // in a queue or running
+        bool                        m_stop{ false };
+
+        std::atomic<size_t>         m_next{ 0 };    // round robin for submissions from outside
+
+        // which pool's worker this thread is, and which of its workers: a task on one pool may submit to another
+        struct Worker
+        {
+            const ThreadPool*   pool;
+            int                 index;
+        };
+        static Worker& this_worker() { static thread_local Worker worker{ nullptr, -1 };  return worker; }
+
+    public:
+        // 0 means one worker per core
+        explicit ThreadPool( size_t size = 0 ) : m_size{ size } { }
+
+        ~ThreadPool() { stop(); }
+
+        ThreadPool( const ThreadPool& ) = delete;
+        void operator=( const ThreadPool& ) = delete;
+
+        static ThreadPool& shared() { static ThreadPool pool;  return pool; }
+
+        size_t size() const
+        {
+            if( m_size )
+                return m_size;
+            size_t cores = std::thread::hardware_concurrency();
+            return cores ? cores : 1;
+        }
+
+        // Only before the workers have started: false (and the size left as it is) once they have.
+        // Resizing a running pool would mean joining its workers, and one finishing an offloaded call
+        // waits for the GIL, which whoever calls this from Python is holding.
+        bool set_size( size_t size )
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            if( ! m_threads.empty() )
+                return size == m_size;
+            m_size = size;
+            return true;
+        }
+
+        void submit( Task task )
+        {
+            start();
+
+            const Worker& self = this_worker();
+            size_t q = self.pool == this ? static_cast<size_t>(self.index) : m_next++ % m_queues.size();
+            {
+                std::lock_guard<std::mutex> lock{ m_queues[q]->mutex };
+                m_queues[q]->tasks.push_back( std::move(task) );
+            }
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_queued++;
+                m_pending++;
+            }
+            m_work.notify_one();
+        }
+
+        // block until every task submitted so far has run (not from a worker: it would wait for itself)
+        void wait_idle()
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_idle.wait( lock, [this] { return m_pending == 0; } );
+        }
+
+        // finish what is queued, then join the workers
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                if( m_threads.empty() )
+                    return;
+                m_stop = true;
+            }
+            m_work.notify_all();
+            for( auto& t : m_threads )
+                t.join();
+
+            m_threads.clear();
+            m_queues.clear();
+            m_stop = false;
+        }
+
+    private:
+        void start()
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            if( ! m_threads.empty() )
+                return;
+
+            size_t n = size();
+            for( size_t i=0; i < n; i++ )
+                m_queues.push_back( std::unique_ptr<Queue>{ new Queue } );
+            for( size_t i=0; i < n; i++ )
+                m_threads.emplace_back( [this, i] { run( static_cast<int>(i) ); } );
+        }
+
+        void run( int index )
+        {
+            this_worker() = Worker{ this, index };
+            for(;;) {
+                Task task;
+                if( take( static_cast<size_t>(index), task ) ) {
+                    task();
+                    finished();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock{ m_mutex };
+                m_work.wait( lock, [this] { return m_stop || m_queued > 0; } );
+                if( m_stop && m_queued == 0 )
+                    return;
+            }
+        }
+
+        // the newest of our own tasks, else the oldest of someone else's
+        bool take( size_t own, Task& task )
+        {
+            size_t n = m_queues.size();
+            for( size_t k=0; k < n; k++ ) {
+                Queue& q = *m_queues[ (own + k) % n ];
+                std::lock_guard<std::mutex> lock{ q.mutex };
+                if( q.tasks.empty() )
+                    continue;
+                if( k == 0 ) {
+                    task = std::move( q.tasks.back() );
+                    q.tasks.pop_back();
+                }
+                else {
+                    task = std::move( q.tasks.front() );
+                    q.tasks.pop_front();
+                }
+                std::lock_guard<std::mutex> count{ m_mutex };
+                m_queued--;
+                return true;
+            }
+            return false;
+        }
+
+        void finished()
+        {
+            bool idle;
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                idle = --m_pending == 0;
+            }
+            if( idle )
+                m_idle.notify_all();
+        }
+    };
+}
@@ -78,13 +78,51 @@ namespace Py
 
         const std::string   m_full_module_name;
 
-        PyModuleDef         m_module_def;
-        PyObject*           m_module;
+        PyModuleDef         m_module_def;       // (reset() only)
+        PyObject*           m_module;           // with init(), borrowed: the module owns us
 
     public:
         //virtual ~ExtModule() { };
 
-        // called by the consumer ONCE per 'Py_Initialize ... Py_Finalize' session
+        // the Final module may set this to size the thread pool offloaded methods run on (see Offload.hxx);
+        // 0 leaves it as it is: one worker per core, unless another module chose.
+        // Only until the first offloaded call: from then on the pool keeps the size it started with.
+        static constexpr size_t thread_pool_size = 0;
+
+        /*
+         Multi-phase initialisation (PEP 489), with the module's name as Python imports it:
+
+                extern "C" PyObject* PyInit_mymodule() { return MyModule::init( "mymodule" ); }
+
+         Python makes the module object, then has us fill it (Py_mod_exec): that's when Final is constructed,
+         once per module object, and it lives in the module's state until the module goes.
+         So each interpreter that imports the module (Py_NewInterpreter) gets a Final of its own, and types of its own (see TypeObject).
+         register_methods_and_classes() runs for the first of them in each Py_Initialize ... Py_Finalize session,
+         and what it sets up is plain C++ (method tables, type prototypes, parameter specs), the same for all.
+         The Python objects made from it (parameter names and defaults, interned names) are made by each interpreter
+         for itself, and go with it (see InterpreterObjects); the overloads' type cache is checked against the interpreter.
+
+         So with Python 3.12 the module says it supports several interpreters. What they share holds no Python objects:
+         the method tables and the handlers' per-method statics (which only find a handler's item), and the thread pool,
+         whose jobs take the GIL of the interpreter that offloaded them (see GilAcquire, Offload, CallbackQueue).
+         But not a GIL per interpreter: the registration, the tables and the free lists are only guarded by the one GIL.
+         */
+        static PyObject* init( const char* name )
+        {
+            PyModuleDef& def = multi_phase_def();
+            def.m_name = name;
+            return PyModuleDef_Init( &def );
+        }
+
+        // the Final of a module made by init(), else nullptr
+        static Final* instance( const Object& module )
+        {
+            if( ! PyModule_Check( module.p ) || PyModule_GetDef( module.p ) != &multi_phase_def() )
+                return nullptr;
+            return static_cast<State*>( PyModule_GetState( module.p ) )->instance;
+        }
+
+        // single-phase initialisation, the old way: called by the consumer ONCE per 'Py_Initialize ... Py_Finalize' session
         // MARKER_STARTUP__1.2a module_test_funcmapper::reset()
         static const Object reset()
         {
@@ -116,24 +154,38 @@ namespace Py
         ExtModule(const std::string& name, const std::string& doc )
             : m_name{name}
             , m_doc{doc}
-            , m_full_module_name{  _Py_PackageContext ? _Py_PackageContext : name  }
+            , m_full_module_name{  executing() ? PyModule_GetName( executing() ) : _Py_PackageContext ? _Py_PackageContext : name  }
+            , m_module{ executing() }
         {
             COUT( "ExtModule()" );
 
-            // clear and (re)populate method-map
-            
-            method_map().clear();
+            if( Final::thread_pool_size )
+                ThreadPool::shared().set_size( Final::thread_pool_size );
 
-            // Consumer should implement a static method with this name.
-            // Note: We can't invoke Final *instance* methods from base constructor
-            //  as final object is not constructed yet. But that's okay, logically
-            //  it should be static anyway.
-            // MARKER_STARTUP___2a call register_methods_and_classes()
-            Final::register_methods_and_classes();
+            if( ! m_module || ! registered() )
+            {
+                // clear and (re)populate method-map
+                FuncMapper<Final>::clear_methods();
+
+                // Consumer should implement a static method with this name.
+                // Note: We can't invoke Final *instance* methods from base constructor
+                //  as final object is not constructed yet. But that's okay, logically
+                //  it should be static anyway.
+                // MARKER_STARTUP___2a call register_methods_and_classes()
+                Final::register_methods_and_classes();
+
+                if( m_module ) {
+                    registered() = true;
+                    Py_AtExit( [] { registered() = false; } );
+                }
+            }
 
             // Load all registered methods into module's dictionary.
 
-            //  - First create the module.
+            //  - First create the module (unless Python made it, for init()).
+            if( m_module )
+                PyModule_SetDocString( m_module, m_doc.c_str() );
+            else
             {
                 m_module_def = PyModuleDef{}; // set all to 0
                 
@@ -160,6 +212,60 @@ namespace Py
         Object moduleDictionary() const { return Object{ charge(PyModule_GetDict(m_module)) }; }  // PyModule_GetDict returns borrowed reference
 
     private:
+        struct State
+        {
+            Final* instance;
+        };
+
+        static PyModuleDef& multi_phase_def()
+        {
+            static PyModuleDef_Slot slots[] = {
+                { Py_mod_exec, reinterpret_cast<void*>( exec_func ) },
+            #if PY_VERSION_HEX >= 0x030C0000
+                { Py_mod_multiple_interpreters, Py_MOD_MULTIPLE_INTERPRETERS_SUPPORTED },
+            #endif
+                { 0, nullptr }
+            };
+            // (m_name is init()'s)
+            static PyModuleDef def{ PyModuleDef_HEAD_INIT, nullptr, nullptr, sizeof(State), nullptr, slots, nullptr, nullptr, free_func };
+            return def;
+        }
+
+        // the module init() is filling, while Final is constructed
+        static PyObject*& executing() { static thread_local PyObject* module = nullptr;  return module; }
+
+        // whether register_methods_and_classes() has run this session (for init())
+        static bool& registered() { static bool r = false;  return r; }
+
+        static int exec_func( PyObject* module )
+        {
+            try {
+                executing() = module;
+                Final* instance = new Final;
+                executing() = nullptr;
+                static_cast<State*>( PyModule_GetState( module ) )->instance = instance;
+                return 0;
+            }
+            catch( const Exception& e ) {
+                executing() = nullptr;
+                e.set_or_modify_python_error_indicator();
+            }
+            catch( ... ) {
+                executing() = nullptr;
+                Exception e{ TRACE, "Unknown exception in ExtModule::exec_func" };
+                e.set_or_modify_python_error_indicator();
+            }
+            return -1;
+        }
+
+        static void free_func( void* module )
+        {
+            if( auto* state = static_cast<State*>( PyModule_GetState( static_cast<PyObject*>( module ) ) ) ) {
+                delete state->instance;
+                state->instance = nullptr;
+            }
+        }
+
         // prevent the compiler generating these unwanted functions
         ExtModule      ( const ExtModule<Final> & ) = delete;
         void operator= ( const ExtModule<Final> & ) = delete;
@@ -7,11 +7,18 @@
 #include "ExtObj/ExtObjBase.hxx"
 #include "ExtObj/Bridge.hxx"
 
+#include "ExtObj/Signature.hxx"
+#include "ExtObj/Offload.hxx"
+#include "ExtObj/CallbackQueue.hxx"
 #include "ExtObj/FuncMapper.hxx"
 
 #include "ExtObj/TypeObject.hxx" // requires ExtObjBase
 
+#include "ExtObj/FreeList.hxx"
+
 #include "ExtObj/ExtObject.hxx"
 
 #include "ExtObj/OldStyle.hxx"
 #include "ExtObj/NewStyle.hxx"
+
+#include "ExtObj/WeakRef.hxx"
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 /*
  Notes:
     When we create an instance of an extension object,
@@ -51,6 +53,20 @@
         
         This means that for new-style classes, the PyObject base-class is UNUSED!
 
+        Unless the final class asks for inline storage:
+
+            class Point : public NewStyle<Point> {
+            public:
+                static constexpr bool inline_storage = true;
+                ...
+
+        Then the C++ object isn't new-ed separately: it is constructed in place inside the Python object's
+        own memory, straight after the Bridge (tp_basicsize grows to make room). A Python subclass appends
+        its own fields (__dict__ ...) after tp_basicsize, so the C++ object stays at the same offset
+        in every instance, which is what lets a handler find it without reading m_pycxx_object.
+        One allocation per instance instead of two, and no pointer to chase on each method call.
+        (m_pycxx_object still gets set, so cxxbase_for works either way.)
+
     Search ExtObject.hxx for MARKER_extobj_allocation
 
     http://stackoverflow.com/questions/26961000/c-api-allocating-pytypeobject-extension
@@ -67,6 +83,7 @@ namespace Py
     {
         PyObject_HEAD
         ExtObjBase* m_pycxx_object;
+        PyObject*   m_weaklist;         // for a type that supportWeakrefs()
     };
 
 
@@ -80,5 +97,29 @@ namespace Py
         else
             return (ExtObjBase*)( pyob );
     }
+
+
+    // where a NewStyle final class with inline_storage lives inside its Python object
+    template<typename Final>
+    constexpr size_t inline_offset()
+    {
+        static_assert( alignof(Final) <= alignof(std::max_align_t), "πcxx: inline_storage can't align this class" );
+        return ( sizeof(Bridge) + alignof(Final) - 1 ) / alignof(Final) * alignof(Final);
+    }
+
+    template<typename Final>
+    inline Final* inline_object( PyObject* pyob )
+    {
+        return reinterpret_cast<Final*>( reinterpret_cast<char*>(pyob) + inline_offset<Final>() );
+    }
+
+    // where a member of a Class sits, measured from its Base part: what tp_members and tp_weaklistoffset want
+    // (worked out on a made-up address: nothing is read, we only want the distance)
+    template<typename Class, typename Base = Class, typename Member, typename Owner>
+    inline Py_ssize_t member_offset( Member Owner::* member )
+    {
+        auto o = reinterpret_cast<Class*>( alignof(std::max_align_t) * 64 );
+        return reinterpret_cast<const char*>( &( o->*member ) ) - reinterpret_cast<const char*>( static_cast<Base*>(o) );
+    }
 }
 
@@ -0,0 +1,491 @@
+#pragma once
+
+#if __cplusplus >= 201703L
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#endif
+
+/*
+ CallbackQueue (requires C++17)
+
+ Events from C++ threads, delivered to a Python callable in batches.
+ A producer pushes without the GIL (a push is a short lock on the queue, nothing more),
+ and the events reach the callable later, many of them to one taking of the GIL:
+
+        CallbackQueue<Tick> ticks{ on_tick, CallbackWake::thread, CallbackDelivery::each, 1024, &Tick::to_python };
+
+        // on the feed's thread
+        ticks.push( Tick{ ... } );
+
+ The first push onto an empty queue wakes the delivery, which is one of:
+    pending_call    Py_AddPendingCall: the main thread drains the queue between two bytecodes.
+                    Only while it's running Python code, not while it's blocked in C (time.sleep, a join...),
+                    and only in the main interpreter: a queue made in a subinterpreter can't have it
+    fd              an eventfd (a pipe where there isn't one) becomes readable, for an event loop to watch:
+                        ticks.add_reader( loop );       // loop.add_reader( fd, drain )
+    thread          the queue's own thread takes the GIL, drains, and lets go
+    manual          nothing: call drain() yourself, holding the GIL
+
+ A wake-up delivers at most 'batch' events, then wakes again if there are more, so a flood doesn't starve other Python code.
+ Events are delivered in the order they were pushed.
+
+ With CallbackDelivery::each the callable is called once per event, callback( event ): through vectorcall, so no args tuple,
+ or where the callable doesn't do vectorcall, with one tuple reused as long as nothing kept hold of it from the last call.
+ With CallbackDelivery::batch it's called once per batch, with a list of the events.
+
+ An event is converted with to_python if given, else with Object's constructor (ints, floats, strings).
+ An exception from the callable doesn't stop the rest of the batch: it goes to sys.unraisablehook, as from a __del__.
+
+ If Py_AddPendingCall fails (CPython's queue of pending calls holds 32), the events wait for the next push.
+ CPython (3.11 at least) doesn't wake the main thread for a call added from another thread: see nudge().
+
+ The callable is called in the interpreter the queue was made in (see GilAcquire).
+
+ A CallbackQueue is a handle: copies share the one queue, so each producer may keep its own.
+ Events still queued when the last copy goes are dropped, and that must happen before its interpreter ends (Python is finalized).
+ */
+
+namespace Py
+{
+    enum class CallbackWake     { pending_call, fd, thread, manual };
+    enum class CallbackDelivery { each, batch };
+
+    template< typename Event >
+    class CallbackQueue
+    {
+        static_assert( ! holds_python<Event>::value, "πcxx: a CallbackQueue event is pushed without the GIL, so it can't be a Python object" );
+
+    public:
+        using ToPython = Object (*)( const Event& );
+
+    private:
+        struct State : std::enable_shared_from_this<State>
+        {
+            std::mutex              mutex;              // guards events, woken, awaiting and stop
+            std::condition_variable ready;              // an event (thread), a pending call to see to (pending_call), or stop
+            std::deque<Event>       events;
+            bool                    woken{ false };     // a wake-up is on its way, or the drain under way will wake again
+            bool                    awaiting{ false };  // (pending_call) a pending call from another thread hasn't run yet
+            bool                    stop{ false };
+
+            // with the GIL (of interp: the one the queue was made in)
+            PyInterpreterState*     interp;
+            PyObject*               callback;
+            PyObject*               args{ nullptr };    // the reused tuple, for a callable without vectorcall
+            std::vector<Event>      taken;              // the batch being delivered
+            bool                    draining{ false };
+            bool                    again{ false };     // a wake-up arrived during the drain
+            size_t                  drains{ 0 };
+
+            std::atomic<size_t>     delivered{ 0 };     // (read without the GIL, to wait on)
+
+            const CallbackWake      wake;
+            const CallbackDelivery  delivery;
+            const size_t            batch;
+            const ToPython          to_python;
+            int                     fd[2]{ -1, -1 };    // read end, write end (the same eventfd twice)
+            std::thread             thread;             // delivers (thread), or nudges (pending_call)
+
+            State( PyObject* cb, CallbackWake w, CallbackDelivery d, size_t b, ToPython tp )
+                : interp{ this_interpreter() }, callback{ cb }, wake{ w }, delivery{ d }, batch{ b ? b : 1 }, to_python{ tp }
+            {
+                Py_INCREF( callback );
+            }
+
+            ~State()
+            {
+                if( thread.joinable() ) {
+                    {
+                        std::lock_guard<std::mutex> lock{ mutex };
+                        stop = true;
+                    }
+                    ready.notify_all();
+                    if( thread.get_id() == std::this_thread::get_id() )
+                        thread.detach();
+                    else if( this_thread_state() ) {
+                        GilRelease unlocked;            // the thread may be waiting for it
+                        thread.join();
+                    }
+                    else
+                        thread.join();
+                }
+#ifndef _WIN32
+                if( fd[0] >= 0 )            close( fd[0] );
+                if( fd[1] >= 0 && fd[1] != fd[0] ) close( fd[1] );
+#endif
+                if( Py_IsInitialized() ) {
+                    GilAcquire locked{ interp };
+                    Py_DECREF( callback );
+                    Py_XDECREF( args );
+                }
+            }
+        };
+
+        std::shared_ptr<State> m_state;
+
+    public:
+        CallbackQueue( const Object& callback, CallbackWake wake = CallbackWake::pending_call,
+                       CallbackDelivery delivery = CallbackDelivery::each, size_t batch = 1024, ToPython to_python = nullptr )
+            : m_state{ std::make_shared<State>( callback.p, wake, delivery, batch, to_python ) }
+        {
+            if( wake == CallbackWake::pending_call && m_state->interp != PyInterpreterState_Main() )
+                THROW( "CallbackQueue: CallbackWake::pending_call only works in the main interpreter" );
+            if( wake == CallbackWake::fd )
+                open_fd( *m_state );
+            // (the State joins the thread, so a plain pointer)
+            if( wake == CallbackWake::thread )
+                m_state->thread = std::thread{ [s = m_state.get()] { run( *s ); } };
+            if( wake == CallbackWake::pending_call )
+                m_state->thread = std::thread{ [s = m_state.get()] { nudge( *s ); } };
+        }
+
+        // from any thread, with or without the GIL
+        void push( Event event )
+        {
+            State& s = *m_state;
+            bool wake;
+            {
+                std::lock_guard<std::mutex> lock{ s.mutex };
+                s.events.push_back( std::move( event ) );
+                wake = ! s.woken;
+                s.woken = true;
+            }
+            if( wake )
+                wake_up( s );
+        }
+
+        // a burst of events, for one lock
+        template< typename It >
+        void push( It first, It last )
+        {
+            State& s = *m_state;
+            bool wake;
+            {
+                std::lock_guard<std::mutex> lock{ s.mutex };
+                s.events.insert( s.events.end(), first, last );
+                wake = ! s.woken && ! s.events.empty();
+                s.woken = s.woken || wake;
+            }
+            if( wake )
+                wake_up( s );
+        }
+
+        // holding the GIL: deliver up to 'batch' of the queued events, returning how many
+        size_t drain() { return drain( *m_state ); }
+
+        // queued, not yet delivered
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock{ m_state->mutex };
+            return m_state->events.size();
+        }
+
+        size_t delivered() const { return m_state->delivered.load( std::memory_order_acquire ); }
+
+        // how many times the callable was given events (a call per batch, or a run of calls per batch)
+        size_t drains() const { return m_state->drains; }
+
+        // (fd) what an event loop should watch
+        int fileno() const { return m_state->fd[0]; }
+
+        // a Python callable that drains the queue (it shares the queue, like a copy of this handle)
+        Object drainer() const
+        {
+            static PyMethodDef def{ "picxx_callback_drain", (PyCFunction)drain_func, METH_NOARGS, nullptr };
+            Object capsule{ PyCapsule_New( new std::shared_ptr<State>{ m_state }, "picxx.CallbackQueue", delete_handle ) };
+            ENSURE_OK( capsule.p );
+            return Object{ PyCFunction_New( &def, capsule.p ) };
+        }
+
+        // (fd) have an asyncio loop drain the queue whenever there are events
+        void add_reader( const Object& loop ) const
+        {
+            if( m_state->wake != CallbackWake::fd )
+                THROW( "CallbackQueue::add_reader: the queue wasn't made with CallbackWake::fd" );
+            loop.call_method( "add_reader"_py, Object{ static_cast<long>( fileno() ) }, drainer() );
+        }
+
+        void remove_reader( const Object& loop ) const
+        {
+            loop.call_method( "remove_reader"_py, Object{ static_cast<long>( fileno() ) } );
+        }
+
+    private:
+        static void wake_up( State& s )
+        {
+            switch( s.wake ) {
+                case CallbackWake::pending_call: {
+                    bool nudge = ! on_pending_call();
+                    if( nudge ) {
+                        std::lock_guard<std::mutex> lock{ s.mutex };
+                        s.awaiting = true;
+                    }
+                    auto* handle = new std::shared_ptr<State>{ s.shared_from_this() };     // (the call may come after the last copy has gone)
+                    if( Py_AddPendingCall( pending, handle ) != 0 ) {
+                        delete handle;
+                        std::lock_guard<std::mutex> lock{ s.mutex };
+                        s.woken = s.awaiting = false;
+                    }
+                    else if( nudge )
+                        s.ready.notify_one();
+                    break;
+                }
+                case CallbackWake::fd:
+                    signal_fd( s );
+                    break;
+                case CallbackWake::thread:
+                    s.ready.notify_one();
+                    break;
+                case CallbackWake::manual:
+                    break;
+            }
+        }
+
+        static bool& on_pending_call() { static thread_local bool on = false;  return on; }
+
+        static int pending( void* arg )
+        {
+            std::unique_ptr< std::shared_ptr<State> > handle{ static_cast< std::shared_ptr<State>* >( arg ) };
+            State& s = **handle;
+            {
+                std::lock_guard<std::mutex> lock{ s.mutex };
+                s.awaiting = false;
+            }
+            on_pending_call() = true;           // (a wake-up from in here is on the main thread: it needs no nudge)
+            drain( s );
+            on_pending_call() = false;
+            return 0;
+        }
+
+        /*
+         (pending_call) In CPython 3.11 at least, Py_AddPendingCall from any thread but the main one sets a flag the main thread
+         only looks at when something else stops it: a signal, or another thread asking for the GIL.
+         So if the call hasn't run after a millisecond, we ask for the GIL, which the main thread,
+         if it's running Python code, hands over within a switch interval, seeing to its pending calls first.
+         If it isn't (blocked in C), we get the GIL at once to no avail, and try again a millisecond later.
+         */
+        static void nudge( State& s )
+        {
+            std::unique_lock<std::mutex> lock{ s.mutex };
+            for(;;) {
+                s.ready.wait( lock, [&s] { return s.stop || s.awaiting; } );
+                if( s.stop )
+                    return;
+                if( s.ready.wait_for( lock, std::chrono::milliseconds(1), [&s] { return s.stop || ! s.awaiting; } ) )
+                    continue;
+                lock.unlock();
+                {
+                    GilAcquire locked{ s.interp };
+                }
+                lock.lock();
+            }
+        }
+
+        static size_t drain( State& s )
+        {
+            // the callable ran Python code, and a pending call got in: it would deliver the rest of the batch out of order
+            if( s.draining ) {
+                s.again = true;
+                return 0;
+            }
+            if( s.wake == CallbackWake::fd )
+                clear_fd( s );
+
+            bool more;
+            {
+                std::lock_guard<std::mutex> lock{ s.mutex };
+                size_t n = std::min( s.batch, s.events.size() );
+                s.taken.clear();
+                std::move( s.events.begin(), s.events.begin() + n, std::back_inserter( s.taken ) );
+                s.events.erase( s.events.begin(), s.events.begin() + n );
+                more = ! s.events.empty();
+                s.woken = more;
+            }
+            size_t n = s.taken.size();
+            if( n ) {
+                s.draining = true;
+                deliver( s );
+                s.draining = false;
+                s.taken.clear();
+                s.drains++;
+                s.delivered.fetch_add( n, std::memory_order_release );
+            }
+
+            if( s.again && ! more ) {
+                std::lock_guard<std::mutex> lock{ s.mutex };
+                more = ! s.events.empty();
+                s.woken = more;
+            }
+            s.again = false;
+            if( more )
+                wake_up( s );
+            return n;
+        }
+
+        static void deliver( State& s )
+        {
+            if( s.delivery == CallbackDelivery::batch ) {
+                Object list{ PyList_New( static_cast<Py_ssize_t>( s.taken.size() ) ) };
+                if( ! list.p ) {
+                    PyErr_WriteUnraisable( s.callback );
+                    return;
+                }
+                for( size_t i=0; i < s.taken.size(); i++ ) {
+                    PyObject* item = convert( s, s.taken[i] ).release();
+                    if( ! item ) {
+                        PyErr_WriteUnraisable( s.callback );
+                        item = Py_None;
+                        Py_INCREF( item );
+                    }
+                    PyList_SET_ITEM( list.p, static_cast<Py_ssize_t>(i), item );
+                }
+                call( s, list.p );
+                return;
+            }
+
+            for( const Event& event : s.taken ) {
+                Object arg = convert( s, event );
+                if( ! arg.p ) {
+                    PyErr_WriteUnraisable( s.callback );
+                    continue;
+                }
+                call( s, arg.p );
+            }
+        }
+
+        // nullptr with the Python error set, if it doesn't convert
+        static Object convert( State& s, const Event& event )
+        {
+            try {
+                if( s.to_python )
+                    return s.to_python( event );
+                if constexpr ( std::is_constructible< Object, const Event& >::value )
+                    return Object{ event };
+                else
+                    THROW( "CallbackQueue: this event type needs a to_python" );
+            }
+            catch( const Exception& e ) {
+                e.set_or_modify_python_error_indicator();
+            }
+            return Object{ (PyObject*)nullptr };
+        }
+
+        static void call( State& s, PyObject* arg )
+        {
+            PyObject* result;
+            if( PyVectorcall_Function( s.callback ) )
+                result = PyObject_Vectorcall( s.callback, &arg, 1, nullptr );
+            else {
+                if( s.args && Py_REFCNT( s.args ) == 1 ) {
+                    PyObject* last = PyTuple_GET_ITEM( s.args, 0 );
+                    Py_INCREF( arg );
+                    PyTuple_SET_ITEM( s.args, 0, arg );
+                    Py_DECREF( last );
+                }
+                else {
+                    Py_XDECREF( s.args );
+                    s.args = PyTuple_Pack( 1, arg );
+                    if( ! s.args ) {
+                        PyErr_WriteUnraisable( s.callback );
+                        return;
+                    }
+                }
+                result = PyObject_Call( s.callback, s.args, nullptr );
+            }
+
+            if( result )
+                Py_DECREF( result );
+            else
+                PyErr_WriteUnraisable( s.callback );
+        }
+
+        // (thread)
+        static void run( State& s )
+        {
+            for(;;) {
+                {
+                    std::unique_lock<std::mutex> lock{ s.mutex };
+                    s.ready.wait( lock, [&s] { return s.stop || ! s.events.empty(); } );
+                    if( s.stop )
+                        return;
+                }
+                GilAcquire locked{ s.interp };
+                drain( s );
+            }
+        }
+
+        static PyObject* drain_func( PyObject* capsule, PyObject* )
+        {
+            auto* handle = static_cast< std::shared_ptr<State>* >( PyCapsule_GetPointer( capsule, "picxx.CallbackQueue" ) );
+            if( ! handle )
+                return nullptr;
+            return PyLong_FromSize_t( drain( **handle ) );
+        }
+
+        static void delete_handle( PyObject* capsule )
+        {
+            delete static_cast< std::shared_ptr<State>* >( PyCapsule_GetPointer( capsule, "picxx.CallbackQueue" ) );
+        }
+
+#pragma mark fd
+
+        static void open_fd( State& s )
+        {
+#if defined(__linux__)
+            s.fd[0] = s.fd[1] = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+            if( s.fd[0] < 0 )
+                THROW( "CallbackQueue: eventfd failed" );
+#elif !defined(_WIN32)
+            if( pipe( s.fd ) != 0 )
+                THROW( "CallbackQueue: pipe failed" );
+            for( int f : s.fd ) {
+                fcntl( f, F_SETFL, fcntl( f, F_GETFL ) | O_NONBLOCK );
+                fcntl( f, F_SETFD, FD_CLOEXEC );
+            }
+#else
+            THROW( "CallbackQueue: CallbackWake::fd isn't available on Windows" );
+#endif
+        }
+
+        static void signal_fd( State& s )
+        {
+#if defined(__linux__)
+            eventfd_write( s.fd[1], 1 );
+#elif !defined(_WIN32)
+            char c = 1;
+            ssize_t r = write( s.fd[1], &c, 1 );        // (a full pipe is readable already)
+            (void)r;
+#endif
+        }
+
+        static void clear_fd( State& s )
+        {
+#if defined(__linux__)
+            eventfd_t count;
+            eventfd_read( s.fd[0], &count );
+#elif !defined(_WIN32)
+            char buf[64];
+            while( read( s.fd[0], buf, sizeof buf ) > 0 )
+                ;
+#endif
+        }
+    };
+}
+
+#endif // C++17
@@ -42,6 +42,13 @@
 
 namespace Py
 {
+    // receives each Object member of an extension object, for the cycle collector (see ExtObjBase::gc_members)
+    class MemberVisitor
+    {
+    public:
+        virtual void operator()( Object& member ) = 0;
+    };
+
     class ExtObjBase : public PyObject
     {
     private:
@@ -85,7 +92,7 @@ namespace Py
         virtual Object  getattro         ( O name)          { return genericGetAttro(name); }
         virtual int     setattro         ( O name, O value) { return genericSetAttro(name, value); }
 
-                Object  genericGetAttro  ( O name)          { return Object{  charge(PyObject_GenericGetAttr( selfPtr(), *name         )) }; }
+                Object  genericGetAttro  ( O name)          { return Object{         PyObject_GenericGetAttr( selfPtr(), *name         )  }; }
                 int     genericSetAttro  ( O name, O value) { return                 PyObject_GenericSetAttr( selfPtr(), *name, *value )   ; }
 
         // Sequence methods
@@ -128,6 +135,11 @@ namespace Py
 
         virtual int buffer_release( Py_buffer* buf ) { return 0; }
         // ^ This method is optional and only required if the buffer's memory is dynamic.
+
+        // Cyclic GC (see TypeObject::supportGC): hand every Object member this object owns to 'visit',
+        //    void gc_members( MemberVisitor& visit ) override { visit( m_callback );  for( auto& o : m_items ) visit( o ); }
+        // The same list serves tp_traverse (visiting) and tp_clear (each member is set to None).
+        virtual void gc_members( MemberVisitor& ) { }
         
 #undef WARN
 
@@ -143,8 +155,14 @@ namespace Py
         template <typename ... Arg>
         Object callOnSelf( const std::string &fn_name,  Arg&&... arg )
         {
-            Object args{ 'T', std::forward<Arg>(arg)... };
-            return  self().callMemberFunction( fn_name, args );
+            return Borrowed{ selfPtr() }.object().call_method( Object{ fn_name }, std::forward<Arg>(arg)... );
+        }
+
+        // for methods called repeatedly: the name is interned once ("on_tick"_py, or an AttrHandle)
+        template<typename... Arg>
+        Object callOnSelf( const Interned& method,  Arg&&... arg )
+        {
+            return Borrowed{ selfPtr() }.object().call_method( method, std::forward<Arg>(arg)... );
         }
         
         virtual PyObject* selfPtr() = 0;
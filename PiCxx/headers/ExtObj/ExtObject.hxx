@@ -106,6 +106,7 @@ namespace Py
           A full discussion of that is at the top of this file.
          */
         // MARKER_STARTUP__3.2b typeobject() single-instance
+        // (the prototype each interpreter's heap type is made from: table() is the type itself)
         static TypeObject& typeobject()
         {
             static TypeObject* t{ nullptr };
@@ -125,7 +126,59 @@ namespace Py
         }
 
     public:
-        static PyTypeObject* table()                    { return typeobject().table(); }
+        // a NewStyle final class may set this true (see Bridge.hxx)
+        static constexpr bool inline_storage = false;
+
+        // a final class may set this to keep up to that many freed instances for reuse (see FreeList.hxx)
+        static constexpr size_t free_list_cap = 0;
+
+        // the memory for C++ instances of Final
+        static FreeList& instance_free_list()
+        {
+            static FreeList list{ sizeof(Final), Final::free_list_cap,
+                                  [] (size_t n) { return ::operator new(n); },
+                                  [] (void* p)  { ::operator delete(p); } };
+            return list;
+        }
+
+        // new Final / delete final go through the free list, if Final has one
+        // (something derived from Final is a different size, and goes to the global allocator)
+        static void* operator new( size_t size )
+        {
+            if( Final::free_list_cap == 0 || size != sizeof(Final) )
+                return ::operator new(size);
+            void* p = instance_free_list().allocate();
+            if( ! p )
+                throw std::bad_alloc{};
+            return p;
+        }
+
+        static void operator delete( void* p, size_t size )
+        {
+            if( Final::free_list_cap == 0 || size != sizeof(Final) )
+                ::operator delete(p);
+            else
+                instance_free_list().deallocate(p);
+        }
+
+        // declaring the above hides the global placement new, which inline_storage needs
+        static void* operator new( size_t, void* where )    { return where; }
+        static void  operator delete( void*, void* )        { }
+
+        // the type in the current interpreter (see TypeObject)
+        // (kept per thread for the last interpreter asked about: one interpreter per thread is the usual case)
+        static PyTypeObject* table()
+        {
+            struct Cached { PyInterpreterState* interp; size_t epoch; PyTypeObject* type; };
+            static thread_local Cached cached{ nullptr, 0, nullptr };
+
+            PyInterpreterState* interp = this_interpreter();
+            size_t epoch = InterpreterTypes::epoch().load( std::memory_order_acquire );
+            if( cached.interp != interp || cached.epoch != epoch || ! cached.type )
+                cached = Cached{ interp, epoch, typeobject().type() };
+            return cached.type;
+        }
+
         static Object        type()                     { return Object{ charge(  (PyObject*)(table())  )  }; }
 
         static bool          check( PyObject* p )       { return p->ob_type == table(); }
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+/*
+ A free list of same-sized memory blocks, for extension objects that get created and destroyed in bulk
+ (vector or quaternion temporaries coming out of number slots, say).
+
+ A freed block is kept (up to the cap) and handed straight back by the next allocation,
+ instead of going through the allocator each time. The final class opts in:
+
+        class Vec3 : public OldStyle<Vec3> {
+        public:
+            static constexpr size_t free_list_cap = 1024;
+            ...
+
+ and ExtObject routes the C++ object through it, via Final's operator new / delete: an OldStyle instance,
+ or a NewStyle Final that isn't inline_storage. (a NewStyle object's Python side comes from pymalloc, which
+ already keeps small blocks of each size class: a list in front of it measured slower, see bench_alloc)
+
+ Final::instance_free_list().stats() shows how well it's working,
+ and set_cap() changes the cap at runtime (0 turns it off, releasing what is kept).
+
+ A free list is not locked: like the rest of the object's life it relies on the GIL being held.
+ Each list is a function-local static with nothing to do when it is destroyed: the blocks it keeps at exit are
+ left to the OS, because the pymalloc ones can't be given back once Py_Finalize has run.
+ */
+
+namespace Py
+{
+    class FreeList
+    {
+    public:
+        struct Stats
+        {
+            size_t  allocations{ 0 };   // blocks handed out
+            size_t  reused{ 0 };        // ...of which came off the list
+            size_t  frees{ 0 };         // blocks given back
+            size_t  released{ 0 };      // ...of which went to the allocator, the list being full
+            size_t  kept{ 0 };          // blocks on the list now
+        };
+
+        using Fresh   = void* (*)( size_t );
+        using Release = void  (*)( void* );
+
+    private:
+        struct Node { Node* next; };
+
+        Node*       m_head{ nullptr };
+        size_t      m_block_size;
+        size_t      m_cap;
+        Fresh       m_fresh;
+        Release     m_release;
+        Stats       m_stats;
+
+    public:
+        FreeList( size_t block_size, size_t cap, Fresh fresh, Release release )
+            : m_block_size{ block_size < sizeof(Node) ? sizeof(Node) : block_size }
+            , m_cap{ cap }
+            , m_fresh{ fresh }
+            , m_release{ release }
+        { }
+
+        FreeList( const FreeList& ) = delete;
+        void operator=( const FreeList& ) = delete;
+
+        size_t          block_size() const  { return m_block_size; }
+        size_t          cap() const         { return m_cap; }
+        const Stats&    stats() const       { return m_stats; }
+
+        // nullptr if the allocator fails
+        void* allocate()
+        {
+            m_stats.allocations++;
+            if( m_head ) {
+                Node* n = m_head;
+                m_head = n->next;
+                m_stats.kept--;
+                m_stats.reused++;
+                return n;
+            }
+            return m_fresh( m_block_size );
+        }
+
+        void deallocate( void* block )
+        {
+            m_stats.frees++;
+            if( m_stats.kept < m_cap ) {
+                m_head = new (block) Node{ m_head };
+                m_stats.kept++;
+                return;
+            }
+            m_stats.released++;
+            m_release( block );
+        }
+
+        void set_cap( size_t cap )
+        {
+            m_cap = cap;
+            while( m_stats.kept > m_cap ) {
+                Node* n = m_head;
+                m_head = n->next;
+                m_stats.kept--;
+                m_release( n );
+            }
+        }
+
+        void reset_stats()
+        {
+            size_t kept = m_stats.kept;
+            m_stats = Stats{};
+            m_stats.kept = kept;
+        }
+    };
+}
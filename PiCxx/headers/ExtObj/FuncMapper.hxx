@@ -1,8 +1,9 @@
 #pragma once
 
-#include <functional>
 #include <vector>
 #include <map>
+#include <array>
+#include <memory>
 
 /*
 
@@ -42,6 +43,8 @@ namespace Py
 
         1. register_method<&Final::FuncMatchingF0_F1_or_F2>( "pyFuncName", "docstring" );
             (F0 F1 F2 ~ No-Args, Var-Args and Keyword, see below)
+            ...or any other signature, e.g. double f(int, const std::string&), see Signature.hxx
+            (typed functions may be registered several times under one name, as overloads)
         
         2. m = methods()["pyFuncName"] to retrieve the associated MethodMapItem
             that got constructed and stored by register_method.
@@ -78,8 +81,8 @@ namespace Py
 
         public:
             ~MethodMapItem() {
-                if( ml_name ) free(ml_name);
-                if( ml_doc ) free(ml_doc);
+                if( ml_name ) free( const_cast<char*>(ml_name) );
+                if( ml_doc ) free( const_cast<char*>(ml_doc) );
             }
 
             // whichever signature matches, that entry gets used
@@ -91,7 +94,22 @@ namespace Py
             MethodMapItem( C name, F0 func, PyCFunction handler, C doc ) : PyMethodDef{ copy(name), handler, METH_NOARGS               , copy(doc) }, f0{func}  {}
             MethodMapItem( C name, F1 func, PyCFunction handler, C doc ) : PyMethodDef{ copy(name), handler, METH_VARARGS              , copy(doc) }, f1{func}  {}
             MethodMapItem( C name, F2 func, PyCFunction handler, C doc ) : PyMethodDef{ copy(name), handler, METH_VARARGS|METH_KEYWORDS, copy(doc) }, f2{func}  {}
+
+            // a typed method (see Signature.hxx) carries everything in its handler
+            MethodMapItem( C name, PyCFunction handler, int flags, C doc )  : PyMethodDef{ copy(name), handler, flags, copy(doc) }  {}
             
+            // position in the method map at registration, so an instance can keep per-method state in a vector
+            size_t index{0};
+
+        #if __cplusplus >= 201703L
+            // for a typed method: the set further overloads join (this name's own), and the handler that dispatches among them
+            std::unique_ptr<OverloadSet>    overloads;
+            PyCFunction                     overload_handler{nullptr};
+
+            // ...registered with a parameter spec: its names and defaults
+            std::unique_ptr<ParamTable>     params;
+        #endif
+
             // Construct a PyFunction_Type object that can call the handler for this method
             //   on a particular instance of the final object (passed in)
             //
@@ -104,36 +122,29 @@ namespace Py
             // http://bytes.com/topic/python/answers/36081-pycfunction_new
             // http://stackoverflow.com/questions/13536669/embedding-python-with-c
             //
-            Object ConstructPyFunc( void* inst )
+            // This allocates (a Binding, its capsule and the function object), so OldStyle caches the result per instance.
+            Object ConstructPyFunc( FuncMapper* inst )
             {
-                // package both the instance calling this method, and this method itself...
-                PyObject* inst_capsule = PyCapsule_New( (void*)inst, nullptr, nullptr ); // PyCapsule_New returns CHARGED pointer
-                PyObject* item_capsule = PyCapsule_New( (void*)this, nullptr, nullptr );
-
-                // ... into a Tuple
-                Object capsules{ 'T', inst_capsule, item_capsule };
-
-                // construct & return a Python callable object that will invoke this handler (passing capsules as first parameter)
-                // The handler will take care of running the method while trapping errors.
-                //
-                // Note that we don't execute the handler at this point
-                // Instead we return this Python function back to the Python runtime
-                // Maybe the Python coder didn't want the function executed but just wanted to grab a pointer to it:
-                //    fp = MyExt.func;
-                // http://bytes.com/topic/python/answers/36081-pycfunction_new
-                // http://stackoverflow.com/questions/13536669/embedding-python-with-c
-                // https://github.com/python/cpython/blob/master/Objects/methodobject.c#L19-L48
-
-                // ^ By charging capsules, we are making sure that the tuple object persists
-                // Which will in turn ensure that the contained capsules persist
-                // http://stackoverflow.com/questions/26716711/documentation-for-pycfunction-new-pycfunction-newex
-                PyObject* func = PyCFunction_New( (PyMethodDef*)this, charge(*capsules) );
+                // package both the instance calling this method, and this method itself, into one capsule
+                // the capsule owns the Binding, and deletes it when the function object lets go of the capsule
+                Object capsule{ PyCapsule_New( new Binding{ inst, this }, nullptr,
+                                              [] (PyObject* c) { delete static_cast<Binding*>( PyCapsule_GetPointer( c, nullptr ) ); } ) };
+                ENSURE_OK( capsule.p );
 
-                // nedbat: don't all functions that create new Python objects have to return new references?
-                return func;
+                // construct & return a Python callable object that will invoke this handler (passing the capsule as first parameter)
+                // https://github.com/python/cpython/blob/master/Objects/methodobject.c#L19-L48
+                // PyCFunction_New takes its own reference to the capsule
+                return Object{ PyCFunction_New( (PyMethodDef*)this, capsule.p ) };
             }
         };
 
+        // what the handler finds in the function object's capsule
+        struct Binding
+        {
+            FuncMapper*     inst;
+            MethodMapItem*  item;
+        };
+
     protected:
 
         // Each templated Final will have its own (static) method map, note that it is ITS duty to copy this into its method-table
@@ -145,6 +156,17 @@ namespace Py
             return m;
         }
 
+        // before registering again (each Py_Initialize): the items go, and with them whatever they own
+        static void clear_methods() {
+            for( auto& m : methods() )
+                delete m.second;
+            methods().clear();
+            session()++;
+        }
+
+        // goes up with each clear_methods()
+        static size_t& session() { static size_t n = 1;  return n; }
+
     private:
         // The final class must call register_method for every method it wishes to expose to Python
         // for those, see below: they will invoke these internal methods.
@@ -155,7 +177,14 @@ namespace Py
             if( methods().find(name) != methods().end() )
                 THROW(  std::string{"internal_register_method: '"} + std::string{name} + std::string{"' is already used"}  );
             else
-                methods()[ name ] = new MethodMapItem{ name, f, h, doc };
+                add_item( name, new MethodMapItem{ name, f, h, doc } );
+        }
+
+        static MethodMapItem* add_item( C name, MethodMapItem* item )
+        {
+            item->index = methods().size();
+            methods()[ name ] = item;
+            return item;
         }
 
 #pragma mark OLD-style class and MODULE
@@ -169,7 +198,7 @@ namespace Py
         // The three above handlers all pipe into this one (to avoid code duplication)
         static PyObject* handler(
                                    int       h_012,
-                                   PyObject* capsules,
+                                   PyObject* capsule,
                                    PyObject* args      = nullptr,
                                    PyObject* keywords  = nullptr
                                    )
@@ -182,7 +211,7 @@ namespace Py
             ExtModule (which constructs a dictionary of Callable objects)
             OldStyle (which intercepts get_attr, and constructs the required Callable object)
             
-            Both of them use ConstructPyFunc(...), which packages (into a Tuple) a pair of capsules that get received here as the first parameter.
+            Both of them use ConstructPyFunc(...), which packages the instance and the method into a capsule that gets received here as the first parameter.
 
             However, NewStyle directly writes a PyMethodDef table for the object,
             which requires a separate static handler for each slot.
@@ -193,28 +222,18 @@ namespace Py
 
             try
             {
-                // Break open the capsules bound to this PyMethodDef and extract...
-                Object t = charge(capsules);
-                
-                PyObject* self_capsule = t[0].ptr(); //  0. a pointer to the Python-object instance that invoked this method
-                PyObject* item_capsule = t[1].ptr(); //  1. a pointer to the MethodMapItem
-
-                void* self_as_void = PyCapsule_GetPointer( self_capsule, nullptr );
-                void* item_as_void = PyCapsule_GetPointer( item_capsule, nullptr );
+                // Break open the capsule bound to this PyMethodDef: the instance that invoked this method, and the MethodMapItem
+                // (the capsule is kept alive by the function object, so a borrowed ref will do)
+                auto binding = static_cast<Binding*>( PyCapsule_GetPointer( capsule, nullptr ) );
 
-                if( self_as_void == nullptr  ||  item_as_void == nullptr )
+                if( binding == nullptr )
                     return nullptr;
-                
-                // Note that (0) is a pointer to an instance of our custom Python object Final,
-                //   which ultimately derives from FuncMapper<Final>
-                // So we can typecast it back to retrieve the associated base
-                auto base = static_cast<FuncMapper*>(self_as_void);
 
-                // Trigger invoke_method on this instance-base feeding in the (1) (which identifies the method that is to be invoked)
-                Object result = base->invoke_method( item_as_void, h_012, args, keywords );
+                // Trigger invoke_method on this instance-base feeding in the MethodMapItem (which identifies the method that is to be invoked)
+                Object result = binding->inst->invoke_method( binding->item, h_012, args, keywords );
 
-                // Give the result back to Python
-                return charge(result.ptr());
+                // Give the result (and our charge on it) back to Python
+                return result.release();
             }
             catch ( const Exception& e )
             {
@@ -233,20 +252,19 @@ namespace Py
         }
 
 
-        Object invoke_method( void* item_as_void, int flag, PyObject* args, PyObject* kwds )
+        Object invoke_method( MethodMapItem* item, int flag, PyObject* args, PyObject* kwds )
         {
             // typecast base back up to final class
             Final* self = static_cast<Final*>(this);
 
             // from OUR method map table (not Python's)...
-            MethodMapItem* item = static_cast<MethodMapItem*>(item_as_void);
 
             COUT( "Invoking: " << item->ml_name );
             
             // ...invoke the method that got registered initially by the final class, returning it's return value
             return flag == 0 ? ( self ->* item->f0 )( )
-                 : flag == 1 ? ( self ->* item->f1 )( to_tuple(args) )
-                             : ( self ->* item->f2 )( to_tuple(args), to_dict(kwds) );
+                 : flag == 1 ? ( self ->* item->f1 )( Borrowed{args} )
+                             : ( self ->* item->f2 )( Borrowed{args}, to_dict(kwds) );
 
             // !!! Section 11.5 of "C++ Tour" may give a better way of doing this
         }
@@ -259,41 +277,60 @@ namespace Py
 
 #pragma mark NEW-STYLE CLASS
 
-    private:
+    protected:
+        // (NewStyle's members and properties use these too)
 
         static Final* final(PyObject* o) {
+            if( Final::inline_storage )
+                return inline_object<Final>(o);
             return static_cast<Final*>(cxxbase_for(o));
         }
 
-        static PyObject* handlerX( int h_012, std::function<Object()> lambda )
+        // The try/catch wrapper around every NewStyle (and typed) method call.
+        // It is a template on the body, so each handler gets its own copy with the call inlined into it:
+        // no std::function, hence no type-erased call and no chance of a heap allocation for the capture.
+        template< typename Body >
+        static PyObject* handlerX( int h_012, Body&& body )
         {
             COUT( "\n   NewStyle handler #" << h_012 );
             try
             {
-                return charge( *lambda() ); // feed charged ref back to Python
+                return body().release(); // feed charged ref back to Python
             }
             catch ( const Exception& e )
             {
-                COUT ("CAUGHT exception in NEW-style-class call-handler");
-                e.set_or_modify_python_error_indicator();
-                return nullptr;
+                return set_error( e );
             }
             catch (...)
             {
-                COUT ("Unknown exception in NEW-style-class call-handler");
-                Exception e{ TRACE, "Unknown exception in NEW-style-class call-handler" };
-                e.set_or_modify_python_error_indicator();
-                return nullptr;
+                return set_unknown_error();
             }
         }
 
-        // Note how we package and pass a lambda, so that we can reuse error trapping rather than have to write the code out three times.
+        // the catch blocks, kept out of line: only the happy path gets stamped out per handler
+        static PyObject* set_error( const Exception& e )
+        {
+            COUT ("CAUGHT exception in NEW-style-class call-handler");
+            e.set_or_modify_python_error_indicator();
+            return nullptr;
+        }
+
+        static PyObject* set_unknown_error()
+        {
+            COUT ("Unknown exception in NEW-style-class call-handler");
+            Exception e{ TRACE, "Unknown exception in NEW-style-class call-handler" };
+            e.set_or_modify_python_error_indicator();
+            return nullptr;
+        }
+
+    private:
+        // Note how we pass the body as a lambda, so that we can reuse error trapping rather than have to write the code out three times.
         // to understand what the code does, imagine no handlerX and no lambda, just executing (final(o) ->* f)(whatever) and forwarding
         // whatever IT returns back to Python.
         #define P PyObject*
         template< F0 f > static P handler( P o, P   )      { return handlerX( 0, [&] ()->Object { return (final(o) ->* f)(                         ); }  ); }
-        template< F1 f > static P handler( P o, P a )      { return handlerX( 1, [&] ()->Object { return (final(o) ->* f)( to_tuple(a)             ); }  ); }
-        template< F2 f > static P handler( P o, P a, P k ) { return handlerX( 2, [&] ()->Object { return (final(o) ->* f)( to_tuple(a), to_dict(k) ); }  ); }
+        template< F1 f > static P handler( P o, P a )      { return handlerX( 1, [&] ()->Object { return (final(o) ->* f)( Borrowed{a}             ); }  ); }
+        template< F2 f > static P handler( P o, P a, P k ) { return handlerX( 2, [&] ()->Object { return (final(o) ->* f)( Borrowed{a}, to_dict(k) ); }  ); }
         #undef P
         
     protected:
@@ -303,6 +340,233 @@ namespace Py
         template <F2 f> static void register_method( C name, C doc=nullptr )  { internal_register_method( name, f, (PyCFunction)&handler<f>, doc ); }
 
 
+#pragma mark TYPED SIGNATURES
+    #if __cplusplus >= 201703L
+    private:
+        template<typename F>
+        static constexpr bool is_classic() { return std::is_same<F,F0>::value || std::is_same<F,F1>::value || std::is_same<F,F2>::value; }
+
+        // For a new-style class self is the Python object (a Bridge);
+        // for a module or old-style class it is the capsule made by ConstructPyFunc
+        static Final* instance( PyObject* self ) {
+            if constexpr ( std::is_base_of<ExtObjBase, Final>::value )
+                if( ! PyCapsule_CheckExact(self) )
+                    return final(self);
+            return static_cast<Final*>( static_cast<Binding*>( PyCapsule_GetPointer( self, nullptr ) )->inst );
+        }
+
+        /*
+         The items f is registered as this session, in order. A typed handler gets its item (the name it was called by,
+         for error messages, and whatever else is the name's own) from here: it is stamped out per position in here (K),
+         since a new-style class's methods all get the instance as self, which unlike a capsule can't say
+         which item was called. (the capsule's item is used where there is one)
+         */
+        static constexpr size_t max_names = 4;
+
+        struct RegisteredAs {
+            size_t                                      session{ 0 };
+            size_t                                      size{ 0 };
+            std::array< MethodMapItem*, max_names >     items{};
+        };
+
+        template<auto f>
+        static RegisteredAs& registered_as() { static RegisteredAs r;  return r; }
+
+        template<auto f, size_t K>
+        static MethodMapItem* called( PyObject* self ) {
+            if constexpr ( std::is_base_of<ExtObjBase, Final>::value )
+                if( ! PyCapsule_CheckExact(self) )
+                    return registered_as<f>().items[K];
+            return static_cast<Binding*>( PyCapsule_GetPointer( self, nullptr ) )->item;
+        }
+
+        // f's next position, for an item about to be registered
+        template<auto f>
+        static size_t next_position( C name )
+        {
+            RegisteredAs& r = registered_as<f>();
+            if( r.session != session() )
+                r = RegisteredAs{ session() };
+            if( r.size == max_names )
+                THROW( std::string{"register_method: '"} + name + "': one function can be registered under at most "
+                       + std::to_string(max_names) + " names" );
+            return r.size;
+        }
+
+        template<auto f>
+        static MethodMapItem* add_at( size_t k, C name, MethodMapItem* item )
+        {
+            registered_as<f>().items[k] = item;
+            registered_as<f>().size = k + 1;
+            return add_item( name, item );
+        }
+
+        // the handler for position k: make( std::integral_constant<size_t, K>{} ) with K == k
+        template<typename Make, size_t... K>
+        static PyCFunction at_position( size_t k, Make make, std::index_sequence<K...> )
+        {
+            const PyCFunction handlers[] = { make( std::integral_constant<size_t, K>{} )... };
+            return handlers[k];
+        }
+
+        // (with nogil, typed_call lets go of the GIL just for the call itself)
+        template<auto f, bool nogil, size_t K>
+        static PyObject* typed_handler( PyObject* self, PyObject* const* args, Py_ssize_t nargs )
+        {
+            // a conversion error comes back as nullptr with the TypeError set, which handlerX passes on as it is
+            return handlerX( 3, [&] () -> Object {
+                Final* inst = std::is_member_function_pointer<decltype(f)>::value ? instance(self) : nullptr;
+                return Object{ typed_call<f, nogil>( f, inst, called<f, K>(self)->ml_name, args, nargs ) };
+            } );
+        }
+
+        // one candidate of an OverloadSet (which passes the name it was called by)
+        template<auto f, bool nogil>
+        static PyObject* typed_probe( const char* fname, PyObject* self, PyObject* const* args, Py_ssize_t nargs, Probe* probe )
+        {
+            Final* inst = std::is_member_function_pointer<decltype(f)>::value ? instance(self) : nullptr;
+            return typed_call<f, nogil>( f, inst, fname, args, nargs, probe );
+        }
+
+        // replaces the handler of the first overload f once a second one is registered
+        template<auto f, size_t K>
+        static PyObject* overloaded_handler( PyObject* self, PyObject* const* args, Py_ssize_t nargs )
+        {
+            return handlerX( 5, [&] () -> Object {
+                MethodMapItem* item = called<f, K>(self);
+                return Object{ item->overloads->call( item->ml_name, self, args, nargs ) };
+            } );
+        }
+
+        template<auto f, bool nogil, size_t K>
+        static PyObject* typed_kw_handler( PyObject* self, PyObject* const* args, Py_ssize_t nargs, PyObject* kwnames )
+        {
+            return handlerX( 4, [&] () -> Object {
+                constexpr size_t N = arity(f);
+                PyObject* bound[ N ? N : 1 ];
+
+                MethodMapItem* item = called<f, K>(self);
+                if( ! item->params->bind( item->ml_name, args, nargs, kwnames, bound ) )
+                    return Object{ (PyObject*)nullptr };        // (the TypeError is set)
+
+                Final* inst = std::is_member_function_pointer<decltype(f)>::value ? instance(self) : nullptr;
+                return Object{ typed_call<f, nogil>( f, inst, item->ml_name, bound, N ) };
+            } );
+        }
+
+        // The Python object whose life inst's is: the task keeps it until it has run.
+        // (for a module or an old-style class self is only the capsule, which doesn't own inst)
+        static Object owner( Final* inst, PyObject* self )
+        {
+            if( ! inst )
+                return Object{ charge(self) };
+            if constexpr ( std::is_base_of<ExtObjBase, Final>::value )
+                return Object{ charge( inst->selfPtr() ) };
+            else
+                return inst->module();
+        }
+
+        template<auto f, bool async, size_t K>
+        static PyObject* offload_handler( PyObject* self, PyObject* const* args, Py_ssize_t nargs )
+        {
+            return handlerX( 7, [&] () -> Object {
+                Final* inst = std::is_member_function_pointer<decltype(f)>::value ? instance(self) : nullptr;
+                return Object{ typed_offload<f>( f, inst, owner( inst, self ).p, async, called<f, K>(self)->ml_name, args, nargs ) };
+            } );
+        }
+
+        // the register_method overloads below (with nogil or without) come here
+        template <auto f, bool nogil>
+        static void register_typed( C name, C doc )
+        {
+            auto found = methods().find(name);
+            if( found != methods().end() ) {
+                MethodMapItem* item = found->second;
+                if( ! item->overloads )
+                    THROW(  std::string{"register_method: '"} + std::string{name} + std::string{"' is already used"}  );
+
+                item->overloads->add( &typed_probe<f, nogil>, name + parameter_list(f) );
+                item->ml_meth = item->overload_handler;
+                return;
+            }
+
+            size_t k = next_position<f>( name );
+            PyCFunction handler = at_position( k, [] (auto K) { return (PyCFunction)(void(*)())&typed_handler<f, nogil, decltype(K)::value>; },
+                                               std::make_index_sequence<max_names>{} );
+            MethodMapItem* item = add_at<f>( k, name, new MethodMapItem{ name, handler, METH_FASTCALL, doc } );
+
+            // ready for overloads
+            item->overloads.reset( new OverloadSet );
+            item->overloads->add( &typed_probe<f, nogil>, name + parameter_list(f) );
+            item->overload_handler = at_position( k, [] (auto K) { return (PyCFunction)(void(*)())&overloaded_handler<f, decltype(K)::value>; },
+                                                  std::make_index_sequence<max_names>{} );
+        }
+
+        template <auto f, bool nogil>
+        static void register_typed( C name, std::initializer_list<Param> params, C doc )
+        {
+            if( methods().find(name) != methods().end() )
+                THROW(  std::string{"register_method: '"} + std::string{name} + std::string{"' is already used"}  );
+
+            std::unique_ptr<ParamTable> table{ new ParamTable };
+            table->set( params );
+            if( table->size() != arity(f) )
+                THROW( std::string{"register_method: '"} + name + "' has " + std::to_string(arity(f)) + " parameters but "
+                       + std::to_string(table->size()) + " are named" );
+
+            std::string full_doc = table->text_signature(name) + ( doc ? doc : "" );
+
+            size_t k = next_position<f>( name );
+            PyCFunction handler = at_position( k, [] (auto K) { return (PyCFunction)(void(*)())&typed_kw_handler<f, nogil, decltype(K)::value>; },
+                                               std::make_index_sequence<max_names>{} );
+            add_at<f>( k, name, new MethodMapItem{ name, handler, METH_FASTCALL | METH_KEYWORDS, full_doc.c_str() } )->params = std::move(table);
+        }
+
+    protected:
+        // any other signature: arguments and result are converted according to the C++ types (see Signature.hxx)
+        //    register_method< &Final::scale >( "scale" );      // Object scale( double, const std::string& ) ... whatever
+        // works for a module, an old-style class or a new-style class, and for member or free functions
+        //
+        // Registering another typed function under a name already used by one makes them overloads (see OverloadSet):
+        // the method's handler then dispatches on the arguments. The doc of the first registration is kept.
+        template <auto f, subfail_unless_t< ! is_classic<decltype(f)>() > = 0>
+        static void register_method( C name, C doc=nullptr )                                            { register_typed<f, false>( name, doc ); }
+
+        // ...with named parameters, defaults and keyword-only ones:
+        //    register_method< &Final::plot >( "plot", { arg("x"), arg("color") = "red", kw_only, arg("width") = 1.0 } );
+        template <auto f, subfail_unless_t< ! is_classic<decltype(f)>() > = 0>
+        static void register_method( C name, std::initializer_list<Param> params, C doc=nullptr )       { register_typed<f, false>( name, params, doc ); }
+
+        // ...either of them to run without the GIL, so other Python threads carry on meanwhile:
+        //    register_method< &Final::smooth >( "smooth", nogil );
+        // The arguments are converted with the GIL held, then released for the call, then the result is converted with it held again.
+        // So the function can't take or return Python objects (a static_assert sees to that), and mustn't touch any in its body
+        // (the instance's Object members included: it can use GilAcquire for that). It may run at the same time as
+        // other calls on the same instance, from other threads.
+        template <auto f, subfail_unless_t< ! is_classic<decltype(f)>() > = 0>
+        static void register_method( C name, NoGil, C doc=nullptr )                                     { register_typed<f, true>( name, doc ); }
+
+        template <auto f, subfail_unless_t< ! is_classic<decltype(f)>() > = 0>
+        static void register_method( C name, std::initializer_list<Param> params, NoGil, C doc=nullptr ) { register_typed<f, true>( name, params, doc ); }
+
+        // ...or to run on the thread pool, the call returning a future for the result at once (see Offload.hxx):
+        //    register_method< &Final::build >( "build", offload );          // a concurrent.futures.Future
+        //    register_method< &Final::build >( "build_async", offload_async );  // an asyncio future
+        // (positional arguments only, and no overloads)
+        template <auto f, bool async, subfail_unless_t< ! is_classic<decltype(f)>() > = 0>
+        static void register_method( C name, OffloadTag<async>, C doc=nullptr )
+        {
+            if( methods().find(name) != methods().end() )
+                THROW(  std::string{"register_method: '"} + std::string{name} + std::string{"' is already used"}  );
+
+            size_t k = next_position<f>( name );
+            PyCFunction handler = at_position( k, [] (auto K) { return (PyCFunction)(void(*)())&offload_handler<f, async, decltype(K)::value>; },
+                                               std::make_index_sequence<max_names>{} );
+            add_at<f>( k, name, new MethodMapItem{ name, handler, METH_FASTCALL, doc } );
+        }
+    #endif
+
+
     };
 
 } // Namespace Py
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "structmember.h"   // T_DOUBLE ..., for tp_members
+
 namespace Py
 {
     template<typename Final>
@@ -10,7 +12,8 @@ namespace Py
 
     protected:
         static TypeObject& typeobject() { return ExtObject<Final>::typeobject(); }
-        static PyTypeObject* table()    { return typeobject().table(); }
+        static PyTypeObject* prototype(){ return typeobject().prototype(); }
+        static PyTypeObject* table()    { return ExtObject<Final>::table(); }
 
         static typename FuncMapper<Final>::method_map_t& method_map() {
             return FuncMapper<Final>::methods();
@@ -34,23 +37,42 @@ namespace Py
             //TypeObject& typeobject{ ExtObject<Final>::typeobject() };
 
             // 2-stage init'n: http://stackoverflow.com/questions/573275/python-c-api-object-allocation
-            table()->tp_new = new_func;
-            table()->tp_init = init_func;
+            prototype()->tp_new = new_func;
+            prototype()->tp_init = init_func;
 
-            table()->tp_dealloc = dealloc_func;
+            prototype()->tp_dealloc = dealloc_func;
 
             // this should be named supportInheritance, or supportUseAsBaseType
             // only the new style class allows this
             typeobject().supportClass();
 
-            // always support get and set attr
-            typeobject().supportGetattro();
-            typeobject().supportSetattro();
+            // attribute access goes through the getattro / setattro trampolines only if Final overrides them;
+            // otherwise Python's generic lookup is installed directly, and descriptors (methods, members, properties)
+            // get CPython's fast path
+            if( std::is_same< decltype(&Final::getattro), decltype(&ExtObjBase::getattro) >::value )
+                prototype()->tp_getattro = PyObject_GenericGetAttr;
+            else
+                typeobject().supportGetattro();
+
+            if( std::is_same< decltype(&Final::setattro), decltype(&ExtObjBase::setattro) >::value )
+                prototype()->tp_setattro = PyObject_GenericSetAttr;
+            else
+                typeobject().supportSetattro();
+
+            // Python allocates the Bridge, and with inline_storage the C++ object after it
+            prototype()->tp_basicsize = basicsize();
 
-            method_map().clear();
+            FuncMapper<Final>::clear_methods();
+        #if __cplusplus >= 201703L
+            member_defs().clear();
+            getset_defs().clear();
+        #endif
 
             Final::setup();
 
+            if( typeobject().weakrefs() )
+                prototype()->tp_weaklistoffset = offsetof( Bridge, m_weaklist );
+
             // add our methods to the extension type's method table
             {
                 auto py_method_table = new PyMethodDef[ method_map().size() + 1 ] {}; // +1 for sentinel, which must be 0'd, which it is thx to {}
@@ -61,24 +83,36 @@ namespace Py
                     py_method_table[ i++ ] = *m.second;
                 }
 
-                table()->tp_methods = py_method_table;
+                prototype()->tp_methods = py_method_table;
             }
 
+        #if __cplusplus >= 201703L
+            // ...and data members and properties to its tp_members / tp_getset (each with a zeroed sentinel)
+            if( ! member_defs().empty() )
+                prototype()->tp_members = copy_with_sentinel( member_defs() );
+            if( ! getset_defs().empty() )
+                prototype()->tp_getset  = copy_with_sentinel( getset_defs() );
+        #endif
+
             typeobject().readyType();
         }
 
 
     private:
+        static constexpr size_t basicsize() {
+            return Final::inline_storage ? inline_offset<Final>() + sizeof(Final) : sizeof(Bridge);
+        }
+
         // this will get called when we readyType() on the associated PyTypeObject
         static PyObject* new_func( PyTypeObject* subtype, PyObject* args, PyObject* kwds )
         {
-            // check to make sure subtype is either equal to our PyTypeObject, or derives from it
-            //const TypeObject&  typeObject = ExtObject<Final>::typeobject();
-            if( ! PyType_IsSubtype( subtype, typeobject().table() ) )
+            // check to make sure subtype is either our PyTypeObject, or derives from it
+            // (at least as far as having room for us: which interpreter's type it derives from doesn't matter here)
+            if( static_cast<size_t>( subtype->tp_basicsize ) < basicsize() )
                 throw Exception( "wtf happened?" );
 
             // First we create the Python object.
-            // The type-object's tp_basicsize is set to sizeof(Bridge)
+            // The type-object's tp_basicsize is set to sizeof(Bridge) (plus room for Final, with inline_storage)
             // (Note: We could maybe use PyType_GenericNew for this:
             //   http://stackoverflow.com/questions/573275/python-c-api-object-allocation )
             //
@@ -106,11 +140,16 @@ namespace Py
                 Bridge* bridge{ reinterpret_cast<Bridge*>(self) };
 
                 // NOTE: observe this is where we invoke the constructor, but indirectly (i.e. through final)
-                if( bridge->m_pycxx_object == nullptr )
-                    bridge->m_pycxx_object = new Final{ bridge, to_tuple(args), to_dict(kwds) };
+                // (with inline_storage, in place: new_func zeroed the memory, a null m_pycxx_object means it isn't constructed yet)
+                if( bridge->m_pycxx_object == nullptr ) {
+                    if( Final::inline_storage )
+                        bridge->m_pycxx_object = new ( inline_object<Final>(self) ) Final{ bridge, Borrowed{args}, to_dict(kwds) };
+                    else
+                        bridge->m_pycxx_object = new Final{ bridge, Borrowed{args}, to_dict(kwds) };
+                }
 
                 else
-                    bridge->m_pycxx_object->reinit( to_tuple(args), to_dict(kwds) );
+                    bridge->m_pycxx_object->reinit( Borrowed{args}, to_dict(kwds) );
             }
             catch ( const Exception& e )
             {
@@ -141,14 +180,204 @@ namespace Py
         {
             COUT( "tp_dealloc for NEW-STYLE: " << ADDR(pyob) );
 
+            // the collector mustn't see the object while it is being taken apart
+            if( PyType_IS_GC( Py_TYPE(pyob) ) )
+                PyObject_GC_UnTrack(pyob);
+
+            // (for an instance of a Python subclass too: Python leaves the list to the base that declared it)
+            if( typeobject().weakrefs() )
+                PyObject_ClearWeakRefs(pyob);
+
+            // the instance holds a reference to its heap type (for a Python subclass, subtype_dealloc leaves it to us)
+            PyTypeObject* type = Py_TYPE(pyob);
+
             auto final = static_cast<Final*>( cxxbase_for(pyob) );
 
-            delete final;
-            PyMem_Free(pyob);
+            if( Final::inline_storage ) {
+                if( final )
+                    final->~Final();
+            }
+            else
+                delete final;
+
+            // (for an instance of a Python subclass this is the subclass's tp_free, which knows about its GC header)
+            type->tp_free(pyob);
+            Py_DECREF(type);
 
             //pyob->ob_type->tp_free(self);
         }
 
+#pragma mark DATA MEMBERS AND PROPERTIES
+    #if __cplusplus >= 201703L
+        /*
+         Expose a C++ field or a getter/setter pair as a Python attribute, read and written without a getattro call:
+
+                register_member< &Point::x >( "x" );                              // double x;          (a const field is read-only)
+                register_property< &Point::norm, &Point::set_norm >( "norm" );   // double norm() const;  void set_norm(double);
+                register_property< &Point::id >( "id" );                         // read-only
+
+         These become descriptors in the type's tp_members / tp_getset, found by Python's own attribute lookup.
+         With inline_storage, a field of a type CPython knows (integral, float, double, bool, Object) sits at a fixed offset
+         in the Python object, so it goes in tp_members and CPython reads it straight from memory.
+         Anything else goes in tp_getset, with a getter / setter converting as typed signatures do (see Signature.hxx).
+         */
+    protected:
+        template< auto field >
+        static void register_member( const char* name, const char* doc=nullptr )
+        {
+            using T = field_type<field>;
+            check_unused( name );
+
+            if constexpr ( Final::inline_storage && member_code<T>() >= 0 ) {
+                static_assert( sizeof(Object) == sizeof(PyObject*), "πcxx: T_OBJECT_EX reads an Object as a PyObject*" );
+                Py_ssize_t offset = static_cast<Py_ssize_t>( inline_offset<Final>() ) + member_offset<Final>( field );
+                member_defs().push_back( PyMemberDef{ strdup(name), member_code<T>(), offset, std::is_const<T>::value ? READONLY : 0, doc ? strdup(doc) : nullptr } );
+            }
+            else {
+                setter set = nullptr;
+                if constexpr ( ! std::is_const<T>::value )
+                    set = &set_field<field>;
+                getset_defs().push_back( PyGetSetDef{ strdup(name), &get_field<field>, set, doc ? strdup(doc) : nullptr, nullptr } );
+            }
+        }
+
+        template< auto get, auto set = nullptr >
+        static void register_property( const char* name, const char* doc=nullptr )
+        {
+            check_unused( name );
+
+            ::setter s = nullptr;
+            if constexpr ( ! std::is_same< decltype(set), std::nullptr_t >::value )
+                s = &set_property<set>;
+            getset_defs().push_back( PyGetSetDef{ strdup(name), &get_property<get>, s, doc ? strdup(doc) : nullptr, nullptr } );
+        }
+
+    private:
+        // registered by Final::setup(), installed by one_time_setup()
+        static std::vector<PyMemberDef>& member_defs() { static std::vector<PyMemberDef> defs;  return defs; }
+        static std::vector<PyGetSetDef>& getset_defs() { static std::vector<PyGetSetDef> defs;  return defs; }
+
+        template< typename Def >
+        static Def* copy_with_sentinel( const std::vector<Def>& defs )
+        {
+            auto table = new Def[ defs.size() + 1 ] {};
+            std::copy( defs.begin(), defs.end(), table );
+            return table;
+        }
+
+        static void check_unused( const char* name )
+        {
+            bool used = method_map().count(name) > 0;
+            for( auto& m : member_defs() )  used = used || strcmp( m.name, name ) == 0;
+            for( auto& g : getset_defs() )  used = used || strcmp( g.name, name ) == 0;
+            if( used )
+                THROW( std::string{"register_member / register_property: '"} + name + "' is already used" );
+        }
+
+        // (a trait rather than a function's return type, which would lose the const of a scalar field)
+        template< typename P >               struct field_of;
+        template< typename C, typename T >   struct field_of< T C::* > { using type = T; };
+        template< auto field >               using field_type = typename field_of< decltype(field) >::type;
+
+        template< typename C, typename R, typename A >
+        static A setter_arg( R (C::*)(A) );
+
+        // the structmember.h code for a field CPython can read and write itself, or -1
+        template< typename T >
+        static constexpr int member_code()
+        {
+            using U = typename std::remove_const<T>::type;
+            if constexpr ( std::is_same<U,bool>::value )            return T_BOOL;
+            else if constexpr ( std::is_integral<U>::value ) {
+                constexpr bool s = std::is_signed<U>::value;
+                switch( sizeof(U) ) {
+                    case 1:  return s ? T_BYTE     : T_UBYTE;
+                    case 2:  return s ? T_SHORT    : T_USHORT;
+                    case 4:  return s ? T_INT      : T_UINT;
+                    case 8:  return s ? T_LONGLONG : T_ULONGLONG;
+                }
+                return -1;
+            }
+            else if constexpr ( std::is_same<U,float>::value )      return T_FLOAT;
+            else if constexpr ( std::is_same<U,double>::value )     return T_DOUBLE;
+            else if constexpr ( std::is_same<U,Object>::value )     return T_OBJECT_EX;
+            else                                                    return -1;
+        }
+
+        // the C++ object, or nullptr with an AttributeError if __init__ hasn't made it yet
+        static Final* constructed( PyObject* self )
+        {
+            if( reinterpret_cast<Bridge*>(self)->m_pycxx_object )
+                return FuncMapper<Final>::final(self);
+            PyErr_Format( PyExc_AttributeError, "'%.200s' object is not initialised", Py_TYPE(self)->tp_name );
+            return nullptr;
+        }
+
+        // the value arrives as a typed-signature argument would (nullptr means del, which a C++ field can't do)
+        template< typename T, typename Assign >
+        static int assign( PyObject* value, Assign&& to )
+        {
+            if( ! value ) {
+                PyErr_SetString( PyExc_AttributeError, "can't delete this attribute" );
+                return -1;
+            }
+            PyObject* done = FuncMapper<Final>::handlerX( 6, [&] () -> Object {
+                ArgSlot< typename std::decay<T>::type > slot;
+                if( ! slot.load(value) ) {
+                    if( ! PyErr_Occurred() )
+                        PyErr_Format( PyExc_TypeError, "attribute must be %s, not %.200s", slot.expected, Py_TYPE(value)->tp_name );
+                    return Object{ (PyObject*)nullptr };
+                }
+                to( slot.get() );
+                return None();
+            } );
+            Py_XDECREF(done);
+            return done ? 0 : -1;
+        }
+
+        template< auto field >
+        static PyObject* get_field( PyObject* self, void* )
+        {
+            Final* f = constructed(self);
+            if( ! f )
+                return nullptr;
+            PyObject* result = FuncMapper<Final>::handlerX( 6, [&] () -> Object { return Object{ f->*field }; } );
+            if( ! result && ! PyErr_Occurred() )
+                PyErr_SetString( PyExc_AttributeError, "attribute is not set" );  // a null Object
+            return result;
+        }
+
+        template< auto field >
+        static int set_field( PyObject* self, PyObject* value, void* )
+        {
+            Final* f = constructed(self);
+            if( ! f )
+                return -1;
+            using T = field_type<field>;
+            return assign<T>( value, [f] (auto&& v) { f->*field = v; } );
+        }
+
+        template< auto get >
+        static PyObject* get_property( PyObject* self, void* )
+        {
+            Final* f = constructed(self);
+            if( ! f )
+                return nullptr;
+            return FuncMapper<Final>::handlerX( 6, [&] () -> Object { return Object{ (f->*get)() }; } );
+        }
+
+        template< auto set >
+        static int set_property( PyObject* self, PyObject* value, void* )
+        {
+            Final* f = constructed(self);
+            if( ! f )
+                return -1;
+            using A = decltype( setter_arg(set) );
+            return assign<A>( value, [f] (auto&& v) { (f->*set)(v); } );
+        }
+    #endif
+
+    private:
         // prevent the compiler generating these unwanted functions
         explicit NewStyle( const NewStyle<Final> &other ) = delete;
         void operator=     ( const NewStyle<Final> &rhs   ) = delete;
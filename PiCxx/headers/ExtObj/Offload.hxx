@@ -0,0 +1,218 @@
+#pragma once
+
+#if __cplusplus >= 201703L
+
+#include <optional>
+#include <string_view>
+
+/*
+ Offloaded methods (requires C++17)
+
+ A typed method registered with 'offload' returns at once with a concurrent.futures.Future,
+ its body running on πcxx's thread pool (see ThreadPool.hxx) without the GIL:
+
+        register_method< &Index::build >( "build", offload );             // std::vector<int> build( std::string path, int depth )
+
+        f = index.build( "/data", 3 )         # doesn't wait
+        ...
+        ids = f.result()                      # the std::vector<int>, as a list
+
+ With 'offload_async' the call returns an asyncio future instead (wrap_future of the above, on the running loop):
+
+        ids = await index.build_async( "/data", 3 )
+
+ The arguments are converted straight away, under the GIL, so a TypeError is raised by the call itself.
+ The body runs later on a worker, so it gets its own copies of the arguments: no string_view, const char* or span
+ (they would point into Python objects the caller may have dropped by then), and no Object, as for nogil.
+ The instance (or the module) is kept alive until it has run: for a new-style class that is its Python object,
+ for an old-style class or a module the object owning the C++ one, not the method's capsule.
+
+ When it has, the worker takes the GIL to convert the result and set it on the future, or set the exception:
+ the GIL of the interpreter that made the call, a subinterpreter's included (see GilAcquire).
+ a C++ exception arrives as the RuntimeError a synchronous call would have raised.
+ That is the only time the worker needs the GIL. So the future is set running as it is made, and cancel() won't stop it:
+ checking for a cancel before starting would have each worker wait for the GIL first, which a busy Python thread
+ can hold for a whole switch interval (5 ms).
+
+ The body may run at the same time as anything else, on any worker: it mustn't touch Python objects
+ (the instance's Object members included) without GilAcquire, nor C++ state that other threads use without a lock.
+
+ The pool's size is the ExtModule's thread_pool_size (see ExtModule.hxx).
+ Before Python finalizes, an atexit hook waits for whatever is still queued or running.
+ */
+
+namespace Py
+{
+    // marks a method to run on the thread pool: register_method< &Final::build >( "build", offload )
+    template< bool async >
+    struct OffloadTag { };
+    constexpr OffloadTag<false> offload{};
+    constexpr OffloadTag<true>  offload_async{};
+
+    // Does a value of this type point into a Python object, so only valid during the call?
+    template<typename T> struct borrows_python                      : std::false_type { };
+    template<>           struct borrows_python< std::string_view >  : std::true_type { };
+    template<>           struct borrows_python< const char* >       : std::true_type { };
+#if __cplusplus >= 202002L
+    template<typename T> struct borrows_python< std::span<const T> > : std::true_type { };
+#endif
+
+    template<typename R, typename... A>
+    constexpr bool offload_safe() {
+        return nogil_safe<R, A...>() && ! ( false || ... || borrows_python< typename std::decay<A>::type >::value );
+    }
+
+    class Offloaded
+    {
+    public:
+        // submit job (which returns R, and runs without the GIL), returning the future for its result.
+        // self is the Python object owning whatever the body uses: it is kept alive until then.
+        template< typename R, typename Job >
+        static Object submit( PyObject* self, bool async, Job&& job )
+        {
+            Object future = new_future();
+            Object running{ future.call_method( "set_running_or_notify_cancel"_py ) };
+            drain_at_exit();
+
+            // (the task holds plain pointers: it is destroyed on the worker, without the GIL)
+            PyObject* fut = future.p;
+            Py_INCREF( fut );
+            Py_XINCREF( self );
+            PyInterpreterState* interp = this_interpreter();
+            ThreadPool::shared().submit( [fut, self, interp, job = std::move(job)] () mutable { run<R>( interp, fut, self, job ); } );
+
+            if( ! async )
+                return future;
+
+            Object asyncio{ PyImport_ImportModule( "asyncio" ) };
+            ENSURE_OK( asyncio.p );
+            return asyncio.call_method( "wrap_future"_py, future );
+        }
+
+    private:
+        static Object new_future()
+        {
+            Object futures{ PyImport_ImportModule( "concurrent.futures" ) };
+            ENSURE_OK( futures.p );
+            return futures.getAttr( "Future"_py ).call();
+        }
+
+        // on a worker. interp is the caller's, which waits for the pool before it goes (drain_at_exit)
+        template< typename R, typename Job >
+        static void run( PyInterpreterState* interp, PyObject* fut, PyObject* self, Job& job )
+        {
+            using Value = typename std::conditional< std::is_void<R>::value, bool, R >::type;
+            std::optional< Value >      value;
+            std::optional< Exception >  error;
+            try {
+                if constexpr ( std::is_void<R>::value ) {
+                    job();
+                    value.emplace( true );
+                }
+                else
+                    value.emplace( job() );
+            }
+            catch( const Exception& e )         { error.emplace( e ); }
+            catch( const std::exception& e )    { error.emplace( TRACE, e.what() ); }
+            catch( ... )                        { error.emplace( TRACE, "Unknown exception in offloaded call" ); }
+
+            GilAcquire locked{ interp };
+            {
+                Object result{ (PyObject*)nullptr };
+                if( value ) {
+                    try {
+                        if constexpr ( std::is_void<R>::value )
+                            result = None();
+                        else
+                            result = Object{ std::move( *value ) };
+                    }
+                    catch( const Exception& e ) { error.emplace( e ); }
+                    if( ! result.p && ! error )
+                        error.emplace( TRACE, "Offloaded call: the result didn't convert" );
+                }
+
+                Object done{ result.p ? PyObject_CallMethod( fut, "set_result", "O", result.p ) : set_exception( fut, *error ) };
+                if( ! done.p )
+                    PyErr_WriteUnraisable( fut );
+            }
+            Py_DECREF( fut );
+            Py_XDECREF( self );
+        }
+
+        // the exception the call would have raised, set on the future
+        static PyObject* set_exception( PyObject* fut, const Exception& e )
+        {
+            e.set_or_modify_python_error_indicator();
+
+            PyObject *type, *value, *trace;
+            PyErr_Fetch( &type, &value, &trace );
+            PyErr_NormalizeException( &type, &value, &trace );
+            Object t{ type }, v{ value }, tb{ trace };
+
+            return PyObject_CallMethod( fut, "set_exception", "O", v.p );
+        }
+
+        // once per interpreter: at exit, wait for the pool (letting go of the GIL, which the workers need to finish)
+        static void drain_at_exit()
+        {
+            PyObject* state = interpreter_dict( this_interpreter() );     // borrowed
+            if( ! state || PyDict_GetItemString( state, "picxx.offload_drain" ) )
+                return;
+
+            static PyMethodDef def{ "picxx_offload_drain", (PyCFunction)drain, METH_NOARGS, nullptr };
+            Object drain_func{ PyCFunction_New( &def, nullptr ) };
+            Object atexit{ PyImport_ImportModule( "atexit" ) };
+            ENSURE_OK( atexit.p );
+            atexit.call_method( "register"_py, drain_func );
+
+            PyDict_SetItemString( state, "picxx.offload_drain", Py_True );
+        }
+
+        static PyObject* drain( PyObject*, PyObject* )
+        {
+            {
+                GilRelease unlocked;
+                ThreadPool::shared().wait_idle();
+            }
+            Py_RETURN_NONE;
+        }
+    };
+
+    // Convert the arguments now, run the call on the pool: returns CHARGED ptr to the future, or nullptr with the Python error set
+    template<typename R, typename... A, typename Call, size_t... I>
+    PyObject* offload_apply( const char* name, PyObject* self, bool async, PyObject* const* args, Py_ssize_t nargs, Call&& call, std::index_sequence<I...> seq )
+    {
+        static_assert( offload_safe<R, A...>(), "πcxx: an offloaded function can't take or return Python objects, nor take string_view, const char* or span" );
+
+        std::tuple< ArgSlot< typename std::decay<A>::type > ... > slots;
+        if( ! load_args<A...>( name, args, nargs, slots, seq, nullptr ) )
+            return nullptr;
+
+        // the body gets its own copies, moved out of the slots
+        std::tuple< typename std::decay<A>::type ... > values{ std::move( std::get<I>(slots).get() ) ... };
+
+        return Offloaded::submit<R>( self, async, [call, values = std::move(values)] () mutable -> R { return std::apply( call, values ); } ).release();
+    }
+
+    // free function
+    template<auto f, typename Inst, typename R, typename... A>
+    PyObject* typed_offload( R (*)(A...), Inst*, PyObject* self, bool async, const char* name, PyObject* const* args, Py_ssize_t nargs ) {
+        return offload_apply<R, A...>( name, self, async, args, nargs, [] (auto&... a) -> R { R (*fp)(A...) = f;  return fp( a... ); },
+                                       std::index_sequence_for<A...>{} );
+    }
+
+    // member function (and const member function) of the instance
+    template<auto f, typename Inst, typename R, typename C, typename... A>
+    PyObject* typed_offload( R (C::*)(A...), Inst* inst, PyObject* self, bool async, const char* name, PyObject* const* args, Py_ssize_t nargs ) {
+        return offload_apply<R, A...>( name, self, async, args, nargs, [inst] (auto&... a) -> R { return (static_cast<C*>(inst) ->* f)( a... ); },
+                                       std::index_sequence_for<A...>{} );
+    }
+
+    template<auto f, typename Inst, typename R, typename C, typename... A>
+    PyObject* typed_offload( R (C::*)(A...) const, Inst* inst, PyObject* self, bool async, const char* name, PyObject* const* args, Py_ssize_t nargs ) {
+        return offload_apply<R, A...>( name, self, async, args, nargs, [inst] (auto&... a) -> R { return (static_cast<const C*>(inst) ->* f)( a... ); },
+                                       std::index_sequence_for<A...>{} );
+    }
+}
+
+#endif // C++17
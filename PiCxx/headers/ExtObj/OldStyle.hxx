@@ -22,7 +22,8 @@ namespace Py
           Hence this convenience function to save that ungainly kerfuffle
          */
         static TypeObject& typeobject() { return ExtObject<Final>::typeobject(); }
-        static PyTypeObject* table() { return typeobject().table(); }
+        static PyTypeObject* prototype() { return typeobject().prototype(); }
+        static PyTypeObject* table() { return ExtObject<Final>::table(); }
 
         static typename FuncMapper<Final>::method_map_t& method_map() {
             return FuncMapper<Final>::methods();
@@ -33,23 +34,34 @@ namespace Py
         {
             COUT( "OldStyle::one_time_setup()" );
             // MARKER_STARTUP__3.2a create typeobject()
-            // This is our opportunity to create our own PyTypeObject.
+            // This is our opportunity to set up our own PyTypeObject (the prototype of each interpreter's type).
             // it will get created the first time it is referenced,
-            // which is by calling table(). jumpnext.
-            table()->tp_dealloc =
+            // which is by calling prototype(). jumpnext.
+            prototype()->tp_dealloc =
                 [] (PyObject* t)
                 {
                     COUT( "tp_dealloc for OLD-STYLE: " << ADDR(t) );
+                    if( typeobject().weakrefs() )
+                        PyObject_ClearWeakRefs(t);
                     // Don't do PyMem_Free(t); as Python never actually allocated space, WE did!
+                    PyTypeObject* type = Py_TYPE(t);
                     delete (Final*)(t);
+                    Py_DECREF(type);        // (PyObject_Init took a reference to the heap type)
                 };
 
             //  MARKER_STARTUP__3.3a  typeobject().supportGetattr()
             typeobject().supportGetattr(); // every object must support getattr
 
-            method_map().clear();
+            FuncMapper<Final>::clear_methods();
 
             Final::setup();
+
+            if( PyType_IS_GC( prototype() ) )
+                THROW( "supportGC() needs a NewStyle class: OldStyle objects are allocated by C++" );
+
+            if( typeobject().weakrefs() )
+                prototype()->tp_weaklistoffset = weaklist_offset();
+
             typeobject().readyType();
         }
 
@@ -83,8 +95,8 @@ namespace Py
         {
             //PyTypeObject* table = table();
 
-            if( name == "__name__" && table()->tp_name != nullptr ) return Object{ table()->tp_name };
-            if( name == "__doc__"  && table()->tp_doc  != nullptr ) return Object{ table()->tp_doc };
+            if( name == "__name__" && Py_TYPE(this)->tp_name != nullptr ) return Object{ Py_TYPE(this)->tp_name };
+            if( name == "__doc__"  && Py_TYPE(this)->tp_doc  != nullptr ) return Object{ Py_TYPE(this)->tp_doc };
 
             // trying to fake out being a class for help()
             else if( name == "__bases__"  )     return Object{'T'};
@@ -116,11 +128,32 @@ namespace Py
 
             // ok, so name WAS found in the method map.
             // return to python a callable object that will invoke this method on this particular instance
+            // It is made on first access and kept, so 'o.method()' doesn't allocate after that.
             COUT( "old-style: Got match!" );
-            return i -> second -> ConstructPyFunc(this);
+            return bound_method( i->second );
         }
 
     private:
+        // one slot per entry in method_map(), filled on first access
+        std::vector<Object> m_bound_methods;
+
+        // weak references to this object, for a type that supportWeakrefs()
+        PyObject* m_weaklist{ nullptr };
+
+        // where m_weaklist sits relative to the PyObject base, which is what Python measures from
+        static Py_ssize_t weaklist_offset() { return member_offset< OldStyle, PyObject >( &OldStyle::m_weaklist ); }
+
+        const Object& bound_method( typename FuncMapper<Final>::method_map_t::mapped_type item )
+        {
+            if( m_bound_methods.size() < method_map().size() )
+                m_bound_methods.resize( method_map().size(), Object{ (PyObject*)nullptr } );
+
+            Object& slot = m_bound_methods[ item->index ];
+            if( slot.isNull() )
+                slot = item->ConstructPyFunc(this);
+            return slot;
+        }
+
         // prevent the compiler generating these unwanted functions
         explicit OldStyle( const OldStyle<Final>& other ) = delete;
         void operator=     ( const OldStyle<Final>& rhs   ) = delete;
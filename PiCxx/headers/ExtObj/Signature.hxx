@@ -0,0 +1,747 @@
+#pragma once
+
+#if __cplusplus >= 201703L
+
+#include <functional>
+#include <tuple>
+#include <vector>
+#include <string_view>
+#include <utility>
+#include <limits>
+#include <type_traits>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+/*
+ Typed method signatures (requires C++17)
+
+ FuncMapper's classic methods take and return Objects, so every call builds an args tuple (and maybe a dict)
+ and the method unpacks it by hand. Instead a method may have an ordinary C++ signature:
+
+        double scale( int n, const std::string& unit, std::span<const double> xs );
+
+        register_method< &MyClass::scale >( "scale", "docs" );
+
+ Python then calls it with METH_FASTCALL: the arguments arrive as a plain PyObject* array,
+ and each one is converted straight into the parameter's C++ type by an ArgSlot chosen at compile time.
+ A mismatch raises TypeError naming the function, the argument and the expected type:
+
+        scale() argument 2 must be str, not int
+
+ Supported parameter types (by value or const&):
+    integral types      int (or __index__), OverflowError if out of range
+    bool                any object, by truthiness
+    float, double       float or int (or __float__)
+    std::string         str (UTF-8 copy)
+    std::string_view    str (no copy: valid during the call)
+    const char*         str (no copy: valid during the call)
+    Object              anything (borrowed: no refcount traffic)
+    std::vector<T>      any sequence (but not str), of a supported T
+    std::span<const T>  T arithmetic: a C-contiguous buffer of T viewed in place (array.array, numpy...),
+                        else any sequence copied (C++20 only)
+
+ The return value goes back through Object's constructors (int, double, bool, std::string, Object ...);
+ a void function returns None.
+
+ Keyword arguments: give the parameters names (and optionally defaults) when registering,
+ one entry per C++ parameter; those after kw_only can only be passed by keyword:
+
+        register_method< &MyClass::plot >( "plot", { arg("x"), arg("y"), arg("color") = "red", kw_only, arg("width") = 1.0 } );
+
+ The method is then registered METH_FASTCALL|METH_KEYWORDS, and keywords are bound to parameter slots
+ by comparing against the interned names (no kwargs dict is made). The doc gets a text signature
+ (plot($self, x, y, color='red', *, width=1.0)), so help() and inspect.signature() show the parameters.
+
+ Overloads: register several typed functions (without parameter specs) under the same name,
+ and each call goes to the first that accepts its arguments (see OverloadSet):
+
+        register_method< &Geometry::transform_point >( "transform" );     // Object transform_point( double, double )
+        register_method< &Geometry::transform_array >( "transform" );     // Object transform_array( std::span<const double> )
+
+ Without the GIL: register_method< &Mesh::smooth >( "smooth", nogil ) converts the arguments, lets go of the GIL
+ for the call, and takes it back to convert the result (see FuncMapper). A string_view, const char* or span argument
+ still points into the Python object then: a str can't change under it, but another thread could write to a buffer.
+ */
+
+namespace Py
+{
+    // Each ArgSlot converts one PyObject* argument into a C++ value and holds it for the duration of the call.
+    //    load(o) returns false on mismatch; if it has not set a Python error itself, the caller raises the TypeError.
+    //    get()   returns what is passed to the C++ function.
+    template<typename T, typename Enable = void>
+    struct ArgSlot {
+        static_assert( sizeof(T) == 0, "πcxx: no conversion from a Python argument to this C++ parameter type" );
+    };
+
+    // integral types
+    template<typename T>
+    struct ArgSlot< T, typename std::enable_if< std::is_integral<T>::value && ! std::is_same<T,bool>::value >::type >
+    {
+        static constexpr const char* expected = "int";
+        T value;
+
+        bool load( PyObject* o ) {
+            if( ! PyLong_Check(o) ) {
+                if( ! PyIndex_Check(o) )
+                    return false;
+                Object as_int{ PyNumber_Index(o) };
+                return as_int.p && load( as_int.p );
+            }
+
+            if( std::is_signed<T>::value ) {
+                long long v = PyLong_AsLongLong(o);
+                if( v == -1 && PyErr_Occurred() )
+                    return false;
+                if( v < static_cast<long long>( std::numeric_limits<T>::min() ) || v > static_cast<long long>( std::numeric_limits<T>::max() ) )
+                    return overflow();
+                value = static_cast<T>(v);
+            }
+            else {
+                unsigned long long v = PyLong_AsUnsignedLongLong(o);
+                if( v == static_cast<unsigned long long>(-1) && PyErr_Occurred() )
+                    return false;
+                if( v > static_cast<unsigned long long>( std::numeric_limits<T>::max() ) )
+                    return overflow();
+                value = static_cast<T>(v);
+            }
+            return true;
+        }
+
+        T get() const { return value; }
+
+    private:
+        static bool overflow() {
+            PyErr_SetString( PyExc_OverflowError, "Python int too large for the C++ parameter type" );
+            return false;
+        }
+    };
+
+    template<>
+    struct ArgSlot< bool >
+    {
+        static constexpr const char* expected = "bool";
+        bool value;
+
+        bool load( PyObject* o ) {
+            int truth = PyObject_IsTrue(o);
+            value = truth == 1;
+            return truth >= 0;
+        }
+
+        bool get() const { return value; }
+    };
+
+    template<typename T>
+    struct ArgSlot< T, typename std::enable_if< std::is_floating_point<T>::value >::type >
+    {
+        static constexpr const char* expected = "float";
+        T value;
+
+        bool load( PyObject* o ) {
+            double v;
+            if( PyFloat_CheckExact(o) )
+                v = PyFloat_AS_DOUBLE(o);
+            else {
+                if( ! PyFloat_Check(o) && ! PyLong_Check(o) && ! PyNumber_Check(o) )
+                    return false;
+                v = PyFloat_AsDouble(o);
+                if( v == -1.0 && PyErr_Occurred() )
+                    return false;
+            }
+
+            if( std::isfinite(v) && ( v > std::numeric_limits<T>::max() || v < std::numeric_limits<T>::lowest() ) ) {
+                PyErr_SetString( PyExc_OverflowError, "Python float too large for the C++ parameter type" );
+                return false;
+            }
+            value = static_cast<T>(v);
+            return true;
+        }
+
+        T get() const { return value; }
+    };
+
+    // str, read through the UTF-8 that the str caches
+    template<>
+    struct ArgSlot< std::string_view >
+    {
+        static constexpr const char* expected = "str";
+        std::string_view value;
+
+        bool load( PyObject* o ) {
+            if( ! PyUnicode_Check(o) )
+                return false;
+            Py_ssize_t n;
+            const char* utf8 = PyUnicode_AsUTF8AndSize( o, &n );
+            if( ! utf8 )
+                return false;
+            value = std::string_view{ utf8, static_cast<size_t>(n) };
+            return true;
+        }
+
+        std::string_view get() const { return value; }
+    };
+
+    template<>
+    struct ArgSlot< std::string > : ArgSlot< std::string_view >
+    {
+        std::string value;
+
+        bool load( PyObject* o ) {
+            if( ! ArgSlot< std::string_view >::load(o) )
+                return false;
+            value.assign( ArgSlot< std::string_view >::value );
+            return true;
+        }
+
+        std::string& get() { return value; }
+    };
+
+    template<>
+    struct ArgSlot< const char* > : ArgSlot< std::string_view >
+    {
+        const char* get() const { return value.data(); }     // PyUnicode_AsUTF8AndSize's buffer is NUL-terminated
+    };
+
+    template<>
+    struct ArgSlot< Object >
+    {
+        static constexpr const char* expected = "object";
+        Borrowed value{ (PyObject*)nullptr };
+
+        bool load( PyObject* o ) { value = Borrowed{o};  return true; }
+
+        const Object& get() const { return value; }
+    };
+
+    // any sequence, element by element
+    template<typename T>
+    struct ArgSlot< std::vector<T> >
+    {
+        static constexpr const char* expected = "a sequence";
+        std::vector<T> value;
+
+        bool load( PyObject* o ) {
+            if( PyUnicode_Check(o) || PyBytes_Check(o) || ! PySequence_Check(o) )
+                return false;
+
+            Object fast{ PySequence_Fast( o, "" ) };
+            if( ! fast.p )
+                return false;
+
+            Py_ssize_t n = PySequence_Fast_GET_SIZE(fast.p);
+            PyObject** items = PySequence_Fast_ITEMS(fast.p);
+            value.clear();
+            value.reserve( static_cast<size_t>(n) );
+
+            for( Py_ssize_t i=0; i < n; i++ ) {
+                ArgSlot< T > item;
+                if( ! item.load( items[i] ) ) {
+                    if( ! PyErr_Occurred() )
+                        PyErr_Format( PyExc_TypeError, "sequence item %zd must be %s, not %.200s", i, ArgSlot< T >::expected, Py_TYPE(items[i])->tp_name );
+                    return false;
+                }
+                value.push_back( item.get() );
+            }
+            return true;
+        }
+
+        std::vector<T>& get() { return value; }
+    };
+
+#if __cplusplus >= 202002L
+    // buffer-protocol format character of a native arithmetic type ('d' for double ...), or 0
+    template<typename T>
+    constexpr char buffer_format() {
+        return std::is_same<T,double>::value             ? 'd'
+             : std::is_same<T,float>::value              ? 'f'
+             : std::is_same<T,signed char>::value        ? 'b'
+             : std::is_same<T,unsigned char>::value      ? 'B'
+             : std::is_same<T,short>::value              ? 'h'
+             : std::is_same<T,unsigned short>::value     ? 'H'
+             : std::is_same<T,int>::value                ? 'i'
+             : std::is_same<T,unsigned int>::value       ? 'I'
+             : std::is_same<T,long>::value               ? 'l'
+             : std::is_same<T,unsigned long>::value      ? 'L'
+             : std::is_same<T,long long>::value          ? 'q'
+             : std::is_same<T,unsigned long long>::value ? 'Q'
+             : 0;
+    }
+
+    // a buffer of exactly T is viewed in place; any other sequence is copied
+    template<typename T>
+    struct ArgSlot< std::span<const T>, typename std::enable_if< std::is_arithmetic<T>::value >::type >
+    {
+        static constexpr const char* expected = "a buffer or sequence of numbers";
+
+        Py_buffer           view{};
+        bool                have_view{ false };
+        ArgSlot< std::vector<T> > copy;
+        std::span<const T>  value;
+
+        ArgSlot() = default;
+        ArgSlot( const ArgSlot& ) = delete;
+        ~ArgSlot() { if( have_view ) PyBuffer_Release( &view ); }
+
+        bool load( PyObject* o ) {
+            if( PyObject_CheckBuffer(o) && PyObject_GetBuffer( o, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS ) == 0 ) {
+                have_view = true;
+                if( view.itemsize == sizeof(T) && matches( view.format ) ) {
+                    value = std::span<const T>{ static_cast<const T*>(view.buf), static_cast<size_t>( view.len / view.itemsize ) };
+                    return true;
+                }
+                PyBuffer_Release( &view );
+                have_view = false;
+            }
+            PyErr_Clear();
+
+            if( ! copy.load(o) )
+                return false;
+            value = std::span<const T>{ copy.value };
+            return true;
+        }
+
+        std::span<const T> get() const { return value; }
+
+    private:
+        static bool matches( const char* format ) {
+            if( ! format )
+                return buffer_format<T>() == 'B';                   // no format means unsigned bytes
+            if( *format == '@' || *format == '=' )
+                format++;
+            return format[0] == buffer_format<T>()  &&  format[1] == '\0';
+        }
+    };
+#endif
+
+    // - - - - - - -
+
+    // What trying one overload found (see OverloadSet)
+    struct Probe
+    {
+        bool matched{ false };
+        bool by_type{ true };       // it failed on the argument types alone, not on a value (out of range, a bad element ...)
+    };
+
+    // Convert the arguments into their slots: returns false with the Python error set.
+    // Given a probe (when trying overloads), arguments that don't fit are not an error:
+    //    probe->matched comes back false, with no Python error set.
+    template<typename... A, typename Slots, size_t... I>
+    bool load_args( const char* name, PyObject* const* args, Py_ssize_t nargs, Slots& slots, std::index_sequence<I...>, Probe* probe )
+    {
+        constexpr Py_ssize_t N = sizeof...(A);
+        if( probe )
+            *probe = Probe{};
+
+        if( nargs != N ) {
+            if( probe )
+                return false;
+            PyErr_Format( PyExc_TypeError, "%s() takes %zd positional argument%s but %zd %s given", name, N, N == 1 ? "" : "s", nargs, nargs == 1 ? "was" : "were" );
+            return false;
+        }
+
+        Py_ssize_t failed = -1;
+        bool ok = ( true && ... && ( std::get<I>(slots).load( args[I] ) || ( failed = I, false ) ) );
+
+        if( ! ok ) {
+            if( probe ) {
+                // an ArgSlot that refuses a type just returns false; one that raised looked at the value
+                probe->by_type = ! PyErr_Occurred();
+                PyErr_Clear();
+                return false;
+            }
+            const char* expected[] = { ArgSlot< typename std::decay<A>::type >::expected ..., nullptr };
+            if( ! PyErr_Occurred() )
+                PyErr_Format( PyExc_TypeError, "%s() argument %zd must be %s, not %.200s", name, failed + 1, expected[failed], Py_TYPE(args[failed])->tp_name );
+            return false;
+        }
+
+        if( probe )
+            probe->matched = true;
+        return true;
+    }
+
+    // Convert the arguments, call, convert the result: returns CHARGED ptr, or nullptr with the Python error set.
+    // 'call' receives the converted arguments.
+    // Given a probe, arguments that don't fit are not an error (see load_args): nothing is called.
+    template<typename R, typename... A, typename Call, size_t... I>
+    PyObject* typed_apply( const char* name, PyObject* const* args, Py_ssize_t nargs, Call&& call, std::index_sequence<I...> seq, Probe* probe )
+    {
+        std::tuple< ArgSlot< typename std::decay<A>::type > ... > slots;
+
+        if( ! load_args<A...>( name, args, nargs, slots, seq, probe ) )
+            return nullptr;
+
+        if constexpr ( std::is_void<R>::value ) {
+            call( std::get<I>(slots).get() ... );
+            return charge( Py_None );
+        }
+        else
+            return Object{ call( std::get<I>(slots).get() ... ) }.release();
+    }
+
+    // Could a value of this type hold a Python object? A nogil function can't take or return one:
+    // without the GIL not even a refcount may change.
+    template<typename T> struct holds_python                    : std::integral_constant< bool, std::is_base_of<Object,T>::value || std::is_same<T,PyObject*>::value > { };
+    template<typename T> struct holds_python< std::vector<T> >  : holds_python< typename std::decay<T>::type > { };
+
+    template<typename R, typename... A>
+    constexpr bool nogil_safe() {
+        return ! ( holds_python< typename std::decay<R>::type >::value || ... || holds_python< typename std::decay<A>::type >::value );
+    }
+
+    #define PICXX_CHECK_NOGIL \
+        static_assert( ! nogil || nogil_safe<R, A...>(), "πcxx: a nogil function can't take or return Python objects (Object, PyObject*, or a vector of them)" )
+
+    // free function
+    // With nogil the arguments are converted first and the result afterwards, the call itself being made without the GIL.
+    template<auto f, bool nogil = false, typename Inst, typename R, typename... A>
+    PyObject* typed_call( R (*)(A...), Inst*, const char* name, PyObject* const* args, Py_ssize_t nargs, Probe* probe = nullptr ) {
+        PICXX_CHECK_NOGIL;
+        return typed_apply<R, A...>( name, args, nargs, [] (auto&&... a) -> R { [[maybe_unused]] GilReleaseIf<nogil> unlocked;  R (*fp)(A...) = f;  return fp( std::forward<decltype(a)>(a)... ); },
+                                     std::index_sequence_for<A...>{}, probe );
+    }
+
+    // member function (and const member function) of the instance
+    template<auto f, bool nogil = false, typename Inst, typename R, typename C, typename... A>
+    PyObject* typed_call( R (C::*)(A...), Inst* inst, const char* name, PyObject* const* args, Py_ssize_t nargs, Probe* probe = nullptr ) {
+        PICXX_CHECK_NOGIL;
+        return typed_apply<R, A...>( name, args, nargs, [inst] (auto&&... a) -> R { [[maybe_unused]] GilReleaseIf<nogil> unlocked;  return (static_cast<C*>(inst) ->* f)( std::forward<decltype(a)>(a)... ); },
+                                     std::index_sequence_for<A...>{}, probe );
+    }
+
+    template<auto f, bool nogil = false, typename Inst, typename R, typename C, typename... A>
+    PyObject* typed_call( R (C::*)(A...) const, Inst* inst, const char* name, PyObject* const* args, Py_ssize_t nargs, Probe* probe = nullptr ) {
+        PICXX_CHECK_NOGIL;
+        return typed_apply<R, A...>( name, args, nargs, [inst] (auto&&... a) -> R { [[maybe_unused]] GilReleaseIf<nogil> unlocked;  return (static_cast<const C*>(inst) ->* f)( std::forward<decltype(a)>(a)... ); },
+                                     std::index_sequence_for<A...>{}, probe );
+    }
+
+    #undef PICXX_CHECK_NOGIL
+
+
+    template<typename R, typename... A>             constexpr size_t arity( R (*)(A...) )             { return sizeof...(A); }
+    template<typename R, typename C, typename... A> constexpr size_t arity( R (C::*)(A...) )          { return sizeof...(A); }
+    template<typename R, typename C, typename... A> constexpr size_t arity( R (C::*)(A...) const )    { return sizeof...(A); }
+
+    // e.g. "(int, str)", from what each ArgSlot expects
+    template<typename... A>
+    std::string parameter_list() {
+        std::string list;
+        for( const char* e : { static_cast<const char*>(nullptr), ArgSlot< typename std::decay<A>::type >::expected ... } )
+            if( e )
+                list += ( list.empty() ? "" : ", " ) + std::string{e};
+        return "(" + list + ")";
+    }
+
+    template<typename R, typename... A>             std::string parameter_list( R (*)(A...) )             { return parameter_list<A...>(); }
+    template<typename R, typename C, typename... A> std::string parameter_list( R (C::*)(A...) )          { return parameter_list<A...>(); }
+    template<typename R, typename C, typename... A> std::string parameter_list( R (C::*)(A...) const )    { return parameter_list<A...>(); }
+
+
+#pragma mark KEYWORD PARAMETERS
+
+    struct KwOnly { };
+
+    // marks the end of the positional parameters in a register_method spec
+    constexpr KwOnly kw_only{};
+
+    // One parameter in a register_method spec: arg("name"), or arg("name") = default_value, or the kw_only marker.
+    // The default is kept as the C++ value, and made into a Python object by each interpreter that needs it.
+    struct Param
+    {
+        const char*                     name{ nullptr };
+        std::function< PyObject*() >    make_default;           // a new reference; empty if required
+        bool                            is_kw_only_marker{ false };
+
+        Param( const char* n )  : name{ n }  { }
+        Param( KwOnly )         : is_kw_only_marker{ true }  { }
+
+        // not const: arg("y") is a non-const temporary, and a const operator= would tie with the
+        // implicit assignment from Param( const char* ) -- arg("y") = 0 would be ambiguous
+        template< typename T, typename = typename std::enable_if< ! std::is_same< typename std::decay<T>::type, Param >::value >::type >
+        Param operator=( T&& value ) {
+            using V = typename std::decay<T>::type;
+            static_assert( ! std::is_base_of<Object, V>::value && ! std::is_same<V, PyObject*>::value,
+                           "πcxx: a default must be a C++ value (each interpreter makes its own Python object from it)" );
+            Param p{ name };
+            p.make_default = [v = V( std::forward<T>(value) )] { return Object{ v }.release(); };
+            return p;
+        }
+    };
+
+    inline Param arg( const char* name ) { return Param{ name }; }
+
+    /*
+     The parameters of one registered name (its MethodMapItem owns the table), prepared once: names interned, defaults made.
+     Both are Python objects, so each interpreter has its own, in its InterpreterObjects, released when it goes:
+     registering again (the next Py_Initialize) only replaces the C++ side.
+     */
+    class ParamTable
+    {
+    private:
+        struct Entry {
+            Interned                        name;
+            std::function< PyObject*() >    make_default;       // empty if required
+            InterpreterObjects::Slot        default_slot;
+        };
+        std::vector<Entry>  m_entries;
+        Py_ssize_t          m_n_positional{ 0 };
+
+        // the names and defaults of the interpreter that called last, borrowed from its table:
+        // a call from that interpreter again (the usual case) needs no lookups
+        struct Resolved {
+            const InterpreterObjects*   table{ nullptr };
+            size_t                      epoch{ 0 };
+            std::vector<PyObject*>      names;
+            std::vector<PyObject*>      defaults;          // nullptr if required
+        };
+        mutable Resolved    m_resolved;
+
+    public:
+        void set( std::initializer_list<Param> params )
+        {
+            m_entries.clear();
+            m_resolved = Resolved{};
+            m_n_positional = -1;
+
+            for( const Param& p : params ) {
+                if( p.is_kw_only_marker ) {
+                    if( m_n_positional >= 0 )
+                        THROW( "register_method: kw_only given twice" );
+                    m_n_positional = static_cast<Py_ssize_t>( m_entries.size() );
+                    continue;
+                }
+
+                if( ! p.make_default && ! m_entries.empty() && m_entries.back().make_default && ( m_n_positional < 0 ) )
+                    THROW( std::string{"register_method: parameter '"} + p.name + "' without a default follows one with a default" );
+
+                m_entries.push_back( Entry{ Interned{ p.name }, p.make_default, InterpreterObjects::Slot{} } );
+            }
+
+            if( m_n_positional < 0 )
+                m_n_positional = static_cast<Py_ssize_t>( m_entries.size() );
+        }
+
+        size_t size() const { return m_entries.size(); }
+
+        /*
+         Fill bound[0..size()) from the FASTCALL arguments: positionals first, then each keyword into the slot
+         with that name (pointer compare against the interned names, falling back to string compare), then defaults.
+         Returns false with a TypeError set, as Python would word it.
+         */
+        bool bind( const char* fname, PyObject* const* args, Py_ssize_t nargs, PyObject* kwnames, PyObject** bound ) const
+        {
+            const Py_ssize_t N = static_cast<Py_ssize_t>( m_entries.size() );
+
+            if( nargs > m_n_positional ) {
+                PyErr_Format( PyExc_TypeError, "%s() takes at most %zd positional argument%s (%zd given)",
+                              fname, m_n_positional, m_n_positional == 1 ? "" : "s", nargs );
+                return false;
+            }
+
+            for( Py_ssize_t i=0; i < N; i++ )
+                bound[i] = i < nargs ? args[i] : nullptr;
+
+            const Resolved& here = resolved();
+
+            Py_ssize_t nkw = kwnames ? PyTuple_GET_SIZE(kwnames) : 0;
+            for( Py_ssize_t j=0; j < nkw; j++ ) {
+                PyObject* key = PyTuple_GET_ITEM( kwnames, j );
+                Py_ssize_t k = find( key, here );
+
+                if( k < 0 ) {
+                    PyErr_Format( PyExc_TypeError, "%s() got an unexpected keyword argument '%U'", fname, key );
+                    return false;
+                }
+                if( bound[k] ) {
+                    PyErr_Format( PyExc_TypeError, "%s() got multiple values for argument '%U'", fname, key );
+                    return false;
+                }
+                bound[k] = args[ nargs + j ];
+            }
+
+            for( Py_ssize_t i=0; i < N; i++ )
+                if( ! bound[i] ) {
+                    if( ! here.defaults[i] ) {
+                        PyErr_Format( PyExc_TypeError, "%s() missing required argument '%U' (pos %zd)", fname, here.names[i], i+1 );
+                        return false;
+                    }
+                    bound[i] = here.defaults[i];
+                }
+
+            return true;
+        }
+
+        // e.g. "plot($self, x, y, color='red', *, width=1.0)\n--\n\n", the header Python parses into __text_signature__
+        std::string text_signature( const char* fname ) const
+        {
+            std::string sig = std::string{fname} + "($self";
+
+            for( size_t i=0; i < m_entries.size(); i++ ) {
+                if( static_cast<Py_ssize_t>(i) == m_n_positional )
+                    sig += ", *";
+                sig += ", " + m_entries[i].name.text();
+                if( m_entries[i].make_default )
+                    sig += "=" + static_cast<std::string>( default_of( m_entries[i], InterpreterObjects::current() ).repr() );
+            }
+
+            return sig + ")\n--\n\n";
+        }
+
+    private:
+        static const Object& default_of( const Entry& e, InterpreterObjects& here )
+        {
+            return here.get( e.default_slot, e.make_default );
+        }
+
+        const Resolved& resolved() const
+        {
+            InterpreterObjects& here = InterpreterObjects::current();
+            if( m_resolved.table == &here && m_resolved.epoch == InterpreterObjects::epoch() )
+                return m_resolved;
+
+            m_resolved.names.clear();
+            m_resolved.defaults.clear();
+            for( const Entry& e : m_entries ) {
+                m_resolved.names.push_back( e.name.name( here ).p );
+                m_resolved.defaults.push_back( e.make_default ? default_of( e, here ).p : nullptr );
+            }
+            m_resolved.table = &here;
+            m_resolved.epoch = InterpreterObjects::epoch();
+            return m_resolved;
+        }
+
+        Py_ssize_t find( PyObject* key, const Resolved& here ) const
+        {
+            const Py_ssize_t N = static_cast<Py_ssize_t>( m_entries.size() );
+
+            for( Py_ssize_t i=0; i < N; i++ )
+                if( here.names[i] == key )
+                    return i;
+
+            // a keyword built at runtime (e.g. f(**d)) may not be the interned str
+            for( Py_ssize_t i=0; i < N; i++ )
+                if( PyUnicode_Compare( here.names[i], key ) == 0 )
+                    return i;
+
+            return -1;
+        }
+    };
+
+
+#pragma mark OVERLOADS
+
+    /*
+     Several typed functions registered under one name. A call tries them in the order they were registered,
+     and the first whose parameters accept the arguments gets called, so register the most specific first
+     (e.g. int before double, and Object last since it accepts anything).
+
+     Most call sites keep passing the same types, so the set remembers the argument types of the last call
+     and the overload they matched: a repeat call with the same types tries that one first, skipping the
+     candidates before it. That is only remembered when those candidates refused the argument types themselves:
+     if one refused a value (an int out of range for it, a list with the wrong elements) another value of the
+     same type might suit it, so that call is not cached. And if the cached overload no longer accepts the values,
+     resolution starts over from the first.
+     */
+    class OverloadSet
+    {
+    public:
+        // try one overload (fname being the name it was called by): see typed_apply
+        using Try = PyObject* (*)( const char* fname, PyObject* self, PyObject* const* args, Py_ssize_t nargs, Probe* probe );
+
+    private:
+        struct Candidate {
+            Try             call;
+            std::string     signature;      // e.g. "transform(a sequence)", for the error message
+        };
+        std::vector<Candidate>  m_candidates;
+
+        // the argument types of the last call (at most cache_args of them), and the overload they matched.
+        // Types are the interpreter's own, so that interpreter's table (and its epoch) is remembered with them:
+        // a type from another interpreter, or from one that has gone, might be at the same address.
+        static constexpr Py_ssize_t cache_args = 4;
+        Py_ssize_t                  m_cached_nargs{ -1 };
+        PyTypeObject*               m_cached_types[ cache_args ];
+        size_t                      m_cached{ 0 };
+        const InterpreterObjects*   m_cached_table{ nullptr };
+        size_t                      m_cached_epoch{ 0 };
+
+    public:
+        void clear() {
+            m_candidates.clear();
+            m_cached_nargs = -1;
+        }
+
+        void add( Try call, std::string signature ) {
+            m_candidates.push_back( Candidate{ call, std::move(signature) } );
+        }
+
+        size_t size() const { return m_candidates.size(); }
+
+        // returns CHARGED ptr, or nullptr with the Python error set
+        PyObject* call( const char* fname, PyObject* self, PyObject* const* args, Py_ssize_t nargs )
+        {
+            Probe probe;
+            const InterpreterObjects* here = &InterpreterObjects::current();
+
+            bool cached = nargs == m_cached_nargs && here == m_cached_table && m_cached_epoch == InterpreterObjects::epoch();
+            for( Py_ssize_t i=0; cached && i < nargs; i++ )
+                cached = Py_TYPE(args[i]) == m_cached_types[i];
+
+            if( cached ) {
+                PyObject* result = m_candidates[ m_cached ].call( fname, self, args, nargs, &probe );
+                if( probe.matched )
+                    return result;
+            }
+
+            bool by_type = true;
+            for( size_t c=0; c < m_candidates.size(); c++ ) {
+                PyObject* result = m_candidates[c].call( fname, self, args, nargs, &probe );
+                if( probe.matched ) {
+                    remember( by_type ? c : none, args, nargs, here );
+                    return result;
+                }
+                by_type = by_type && probe.by_type;
+            }
+
+            return no_match( fname, args, nargs );
+        }
+
+    private:
+        static constexpr size_t none = static_cast<size_t>(-1);
+
+        void remember( size_t c, PyObject* const* args, Py_ssize_t nargs, const InterpreterObjects* here )
+        {
+            if( c == none || nargs > cache_args ) {
+                m_cached_nargs = -1;
+                return;
+            }
+            for( Py_ssize_t i=0; i < nargs; i++ )
+                m_cached_types[i] = Py_TYPE(args[i]);
+            m_cached_nargs = nargs;
+            m_cached = c;
+            m_cached_table = here;
+            m_cached_epoch = InterpreterObjects::epoch();
+        }
+
+        // e.g. "transform(): no overload accepts (str); candidates are transform(object, object), transform(a sequence)"
+        PyObject* no_match( const char* fname, PyObject* const* args, Py_ssize_t nargs ) const
+        {
+            std::string given;
+            for( Py_ssize_t i=0; i < nargs; i++ )
+                given += ( i ? ", " : "" ) + std::string{ Py_TYPE(args[i])->tp_name };
+
+            std::string candidates;
+            for( const Candidate& c : m_candidates )
+                candidates += ( candidates.empty() ? "" : ", " ) + c.signature;
+
+            PyErr_Format( PyExc_TypeError, "%s(): no overload accepts (%s); candidates are %s", fname, given.c_str(), candidates.c_str() );
+            return nullptr;
+        }
+    };
+
+} // Namespace Py
+
+#endif // C++17
@@ -105,7 +105,12 @@
      In both cases we want to be setting Python's error indicator before returning control back to Python.
 */
 
+#include "structmember.h"   // T_PYSSIZET, for __weaklistoffset__
+
+#include <atomic>
+#include <map>
 #include <typeindex>
+#include <vector>
 
 namespace Py
 {
@@ -128,7 +133,7 @@ namespace Py
         static Object to_cxx(PyObject* p) { return Object{charge(p)}; }  // Python sends us neutral refs
     };
     template<>  struct Convert<Object> {
-        static PyObject* to_c(Object ob) { return charge(*ob); } // ... and expects we send back a charged ref
+        static PyObject* to_c(Object ob) { return ob.release(); } // ... and expects we send back a charged ref
     };
 
     // - - -
@@ -184,8 +189,70 @@ namespace Py
 
 // = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
 
+#pragma mark InterpreterTypes
+
+    class TypeObject;
+
+    /*
+     The heap types made in one interpreter, one for each TypeObject asked for there.
+     They sit in a capsule in the interpreter's dict, so they go when the interpreter does
+     (Py_EndInterpreter, or Py_Finalize for the main one), and each interpreter has types of its own.
+     */
+    class InterpreterTypes
+    {
+    private:
+        std::map< const TypeObject*, PyTypeObject* >  m_types;       // (owned references)
+
+        static constexpr const char* key = "picxx.types";
+
+    public:
+        // goes up whenever an interpreter's types go, so a cached type can be checked before use
+        static std::atomic<size_t>& epoch() { static std::atomic<size_t> e{ 0 };  return e; }
+
+        // the current interpreter's
+        static InterpreterTypes& current()
+        {
+            PyObject* dict = interpreter_dict( this_interpreter() );     // borrowed
+            if( ! dict )
+                THROW( "InterpreterTypes: no interpreter dict" );
+
+            if( PyObject* capsule = PyDict_GetItemString( dict, key ) )
+                return *static_cast<InterpreterTypes*>( PyCapsule_GetPointer( capsule, key ) );
+
+            auto* types = new InterpreterTypes;
+            Object capsule{ PyCapsule_New( types, key, [] (PyObject* c) { delete static_cast<InterpreterTypes*>( PyCapsule_GetPointer( c, key ) ); } ) };
+            if( ! capsule.p ) {
+                delete types;
+                throw_if_pyerr(TRACE);
+            }
+            if( PyDict_SetItemString( dict, key, capsule.p ) < 0 )
+                throw_if_pyerr(TRACE);
+            return *types;
+        }
+
+        PyTypeObject* find( const TypeObject* t ) const
+        {
+            auto i = m_types.find( t );
+            return i == m_types.end() ? nullptr : i->second;
+        }
+
+        void add( const TypeObject* t, PyTypeObject* type ) { m_types[t] = type; }
+
+        ~InterpreterTypes()
+        {
+            epoch()++;
+            for( auto& t : m_types )
+                Py_DECREF( t.second );
+        }
+    };
+
 #pragma mark TypeObject
 
+    /*
+     A TypeObject is the prototype of an extension type: the slots, flags and tables setup() gives it.
+     Python never sees it. Each interpreter gets a heap type made from it by PyType_FromSpec the first time
+     it asks for one (type()), so no Python object is shared between interpreters.
+     */
     class TypeObject
     {
     private:
@@ -208,8 +275,11 @@ namespace Py
 
         std::string             m_name;
         std::string             m_doc;
+
+        bool                    m_weakrefs{ false };
     public:
-        PyTypeObject* table() const
+        // for setup: the slots the heap types are made with
+        PyTypeObject* prototype() const
         {
             return m_table;
         }
@@ -239,7 +309,9 @@ namespace Py
             m_table->tp_itemsize          = 0;
             
             m_table->tp_dealloc           = 0; // (destructor) [](PyObject* pyob){ PyMem_Free(pyob); };
+#if PY_VERSION_HEX < 0x03080000
             m_table->tp_print             = 0;
+#endif
             m_table->tp_getattr           = 0; // Methods to implement standard operations
             m_table->tp_setattr           = 0;
             m_table->tp_repr              = 0;
@@ -438,11 +510,199 @@ namespace Py
            
         }
         
-        // call (once all support functions have been called) to ready the type
+        /*
+         An object holding Objects that may lead back to it (a callback registry, a parent pointer ...) makes a cycle
+         that reference counting never frees. With supportGC() Python's cycle collector can see such cycles and break them:
+         the final class lists its members in gc_members() (see ExtObjBase), and we generate tp_traverse and tp_clear from that.
+
+         NewStyle only: an OldStyle object is allocated by C++ new, without the header the collector keeps in front of each object.
+         */
+        void supportGC()
+        {
+            m_table->tp_flags   |= Py_TPFLAGS_HAVE_GC;
+            m_table->tp_traverse = traverse;
+            m_table->tp_clear    = clear;
+        }
+
+        /*
+         Let Python hold weak references to instances: weakref.ref(obj), WeakValueDictionary, and WeakRef<Final> in C++.
+         Each instance needs a slot for its list of weak references: OldStyle keeps one in the object, NewStyle in its Bridge.
+         one_time_setup() points tp_weaklistoffset at it, and the object's dealloc clears the references.
+         */
+        void supportWeakrefs()  { m_weakrefs = true; }
+        bool weakrefs() const   { return m_weakrefs; }
+
+    private:
+        static int traverse( PyObject* self, visitproc visit, void* arg )
+        {
+            struct Visit : MemberVisitor {
+                visitproc   visit;
+                void*       arg;
+                int         result{ 0 };
+
+                void operator()( Object& member ) override {
+                    if( result == 0 && ! member.isNull() )
+                        result = visit( member.p, arg );
+                }
+            } v;
+            v.visit = visit;
+            v.arg = arg;
+
+            // (the collector may meet the object between tp_alloc and the C++ object's construction)
+            if( ExtObjBase* base = cxxbase_for(self) )
+                base->gc_members(v);
+            if( v.result )
+                return v.result;
+
+            // an instance holds a reference to its heap type
+            Py_VISIT( Py_TYPE(self) );
+            return 0;
+        }
+
+        static int clear( PyObject* self )
+        {
+            struct Clear : MemberVisitor {
+                void operator()( Object& member ) override {
+                    if( ! member.isNull() )
+                        member = None();
+                }
+            } c;
+
+            if( ExtObjBase* base = cxxbase_for(self) )
+                base->gc_members(c);
+            return 0;
+        }
+
+    public:
+        // call (once all support functions have been called) to make the type for the current interpreter
         bool readyType() {
-            return PyType_Ready(m_table) >= 0;
+            try {
+                type();
+            }
+            catch( const Exception& ) {
+                return false;
+            }
+            return true;
+        }
+
+        // the heap type for the current interpreter, made the first time
+        PyTypeObject* type()
+        {
+            InterpreterTypes& types = InterpreterTypes::current();
+            if( PyTypeObject* t = types.find( this ) )
+                return t;
+
+            PyTypeObject* t = from_spec();
+            types.add( this, t );
+            return t;
         }
 
+    private:
+        // one of from_spec()'s slots, if the prototype has it
+        template< typename F >
+        static void add_slot( std::vector< PyType_Slot >& slots, int id, F f )
+        {
+            if( f )
+                slots.push_back( PyType_Slot{ id, reinterpret_cast<void*>( f ) } );
+        }
+
+        // a PyType_Spec of the prototype's slots
+        PyTypeObject* from_spec() const
+        {
+            const PyTypeObject* p = m_table;
+            std::vector< PyType_Slot > slots;
+
+            add_slot( slots, Py_tp_dealloc,        p->tp_dealloc );
+            add_slot( slots, Py_tp_getattr,        p->tp_getattr );
+            add_slot( slots, Py_tp_setattr,        p->tp_setattr );
+            add_slot( slots, Py_tp_repr,           p->tp_repr );
+            add_slot( slots, Py_tp_hash,           p->tp_hash );
+            add_slot( slots, Py_tp_call,           p->tp_call );
+            add_slot( slots, Py_tp_str,            p->tp_str );
+            add_slot( slots, Py_tp_getattro,       p->tp_getattro );
+            add_slot( slots, Py_tp_setattro,       p->tp_setattro );
+            add_slot( slots, Py_tp_traverse,       p->tp_traverse );
+            add_slot( slots, Py_tp_clear,          p->tp_clear );
+            add_slot( slots, Py_tp_richcompare,    p->tp_richcompare );
+            add_slot( slots, Py_tp_iter,           p->tp_iter );
+            add_slot( slots, Py_tp_iternext,       p->tp_iternext );
+            add_slot( slots, Py_tp_methods,        p->tp_methods );
+            add_slot( slots, Py_tp_getset,         p->tp_getset );
+            add_slot( slots, Py_tp_init,           p->tp_init );
+            add_slot( slots, Py_tp_alloc,          p->tp_alloc );
+            add_slot( slots, Py_tp_new,            p->tp_new );
+            add_slot( slots, Py_tp_free,           p->tp_free );
+            if( p->tp_doc )
+                slots.push_back( PyType_Slot{ Py_tp_doc, const_cast<char*>( p->tp_doc ) } );
+
+            if( const PySequenceMethods* sq = p->tp_as_sequence ) {
+                add_slot( slots, Py_sq_length,     sq->sq_length );
+                add_slot( slots, Py_sq_concat,     sq->sq_concat );
+                add_slot( slots, Py_sq_repeat,     sq->sq_repeat );
+                add_slot( slots, Py_sq_item,       sq->sq_item );
+                add_slot( slots, Py_sq_ass_item,   sq->sq_ass_item );
+            }
+            if( const PyMappingMethods* mp = p->tp_as_mapping ) {
+                add_slot( slots, Py_mp_length,         mp->mp_length );
+                add_slot( slots, Py_mp_subscript,      mp->mp_subscript );
+                add_slot( slots, Py_mp_ass_subscript,  mp->mp_ass_subscript );
+            }
+            if( const PyNumberMethods* nb = p->tp_as_number ) {
+                add_slot( slots, Py_nb_int,        nb->nb_int );
+                add_slot( slots, Py_nb_float,      nb->nb_float );
+                add_slot( slots, Py_nb_negative,   nb->nb_negative );
+                add_slot( slots, Py_nb_positive,   nb->nb_positive );
+                add_slot( slots, Py_nb_absolute,   nb->nb_absolute );
+                add_slot( slots, Py_nb_invert,     nb->nb_invert );
+                add_slot( slots, Py_nb_add,        nb->nb_add );
+                add_slot( slots, Py_nb_subtract,   nb->nb_subtract );
+                add_slot( slots, Py_nb_multiply,   nb->nb_multiply );
+                add_slot( slots, Py_nb_remainder,  nb->nb_remainder );
+                add_slot( slots, Py_nb_divmod,     nb->nb_divmod );
+                add_slot( slots, Py_nb_lshift,     nb->nb_lshift );
+                add_slot( slots, Py_nb_rshift,     nb->nb_rshift );
+                add_slot( slots, Py_nb_and,        nb->nb_and );
+                add_slot( slots, Py_nb_xor,        nb->nb_xor );
+                add_slot( slots, Py_nb_or,         nb->nb_or );
+                add_slot( slots, Py_nb_power,      nb->nb_power );
+            }
+            if( const PyBufferProcs* bf = p->tp_as_buffer ) {
+                add_slot( slots, Py_bf_getbuffer,      bf->bf_getbuffer );
+                add_slot( slots, Py_bf_releasebuffer,  bf->bf_releasebuffer );
+            }
+
+            // the members, and the weak reference list's offset as a member too (PyType_FromSpec copies them)
+            std::vector< PyMemberDef > members;
+            for( const PyMemberDef* m = p->tp_members; m && m->name; m++ )
+                members.push_back( *m );
+            if( p->tp_weaklistoffset )
+                members.push_back( PyMemberDef{ "__weaklistoffset__", T_PYSSIZET, p->tp_weaklistoffset, READONLY, nullptr } );
+            if( ! members.empty() ) {
+                members.push_back( PyMemberDef{} );
+                slots.push_back( PyType_Slot{ Py_tp_members, members.data() } );
+            }
+            slots.push_back( PyType_Slot{ 0, nullptr } );
+
+            // like a static type, it can't be changed from Python; without a tp_new, it can't be instantiated from Python either
+            unsigned long flags = p->tp_flags;
+        #ifdef Py_TPFLAGS_IMMUTABLETYPE
+            flags |= Py_TPFLAGS_IMMUTABLETYPE;
+        #endif
+        #ifdef Py_TPFLAGS_DISALLOW_INSTANTIATION
+            if( ! p->tp_new )
+                flags |= Py_TPFLAGS_DISALLOW_INSTANTIATION;
+        #endif
+
+            PyType_Spec spec{ p->tp_name, static_cast<int>( p->tp_basicsize ), static_cast<int>( p->tp_itemsize ),
+                              static_cast<unsigned int>( flags ), slots.data() };
+            PyObject* type = PyType_FromSpec( &spec );
+            if( ! type )
+                throw_if_pyerr(TRACE);
+            return reinterpret_cast<PyTypeObject*>( type );
+        }
+
+    public:
+
         // prevent the compiler generating these unwanted functions
         TypeObject    ( const TypeObject& ) = delete;
         void operator=( const TypeObject& ) = delete;
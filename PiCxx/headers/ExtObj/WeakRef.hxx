@@ -0,0 +1,64 @@
+#pragma once
+
+/*
+ A weak reference to an instance of an extension type, for caches held in C++
+ (the type must supportWeakrefs(), see TypeObject).
+
+ Like std::weak_ptr, it doesn't keep the object alive: lock() gives a strong reference
+ while the object lasts, and a null Object once Python has let go of it.
+
+        std::map< std::string, WeakRef<Mesh> > cache;
+        ...
+        Object mesh = cache[name].lock();
+        if( mesh.isNull() ) {
+            mesh = Mesh::type().call( name );
+            cache[name] = WeakRef<Mesh>{ mesh };
+        }
+        Mesh* m = WeakRef<Mesh>::cxx( mesh );        // valid for as long as 'mesh' is held
+ */
+
+namespace Py
+{
+    template< typename Final >
+    class WeakRef
+    {
+    private:
+        Object m_ref{ (PyObject*)nullptr };     // the Python weakref object
+
+    public:
+        WeakRef() = default;
+
+        explicit WeakRef( const Object& ob )
+        {
+            if( ! PyObject_TypeCheck( ob.p, ExtObject<Final>::table() ) )
+                THROW( std::string{"WeakRef: expected "} + ExtObject<Final>::table()->tp_name + ", not " + Py_TYPE(ob.p)->tp_name );
+
+            m_ref = Object{ PyWeakref_NewRef( ob.p, nullptr ) };
+            throw_if_pyerr(TRACE);
+        }
+
+        // true once the object is gone (or if this never referred to one)
+        bool expired() const { return lock().isNull(); }
+
+        // a strong reference to the object, or a null Object if it is gone
+        Object lock() const
+        {
+            if( m_ref.isNull() )
+                return Object{ (PyObject*)nullptr };
+        #if PY_VERSION_HEX >= 0x030D0000
+            PyObject* ob;
+            PyWeakref_GetRef( m_ref.p, &ob );
+            return Object{ ob };
+        #else
+            PyObject* ob = PyWeakref_GET_OBJECT( m_ref.p );     // borrowed, Py_None if dead
+            return ob == Py_None ? Object{ (PyObject*)nullptr } : Object{ charge(ob) };
+        #endif
+        }
+
+        // the C++ object of a locked reference (nullptr for a null Object)
+        static Final* cxx( const Object& locked )
+        {
+            return locked.isNull() ? nullptr : static_cast<Final*>( cxxbase_for( locked.p ) );
+        }
+    };
+}
@@ -11,8 +11,19 @@
 #include <string>
 #include <iterator>
 #include <utility>
+#include <memory>
+#include <unordered_map>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <mutex>
+#if __cplusplus >= 201703L
+#include <string_view>
+#include <optional>
+#endif
 #include <typeinfo>
 #include <limits>
+#include <cmath>
 #include <stddef.h>
 
 #include <complex>
@@ -119,14 +130,47 @@ namespace Py
      
      NOTE: unless documented otherwise, Python Runtime feeds us neutral pointers, and expects us to return a charged pointer
     */
+
+    /*
+     In debug builds we count every charge/discharge πcxx performs, so that tests can check
+     a code path doesn't generate needless INCREF/DECREF pairs (each one touches the PyObject's cache line).
+     */
+    struct RefTraffic
+    {
+        long charges{0};
+        long discharges{0};
+
+        void reset() { charges = discharges = 0; }
+    };
+    inline RefTraffic& ref_traffic() {
+        static RefTraffic t;
+        return t;
+    }
+
     inline static PyObject* charge( PyObject* pyob ) {
+        IF_DEBUG( if(pyob) ++ref_traffic().charges; )
         Py_XINCREF(pyob);
         return pyob;
     }
 
+    inline static void discharge( PyObject* pyob ) {
+        IF_DEBUG( if(pyob) ++ref_traffic().discharges; )
+        Py_XDECREF(pyob);
+    }
+
 
 #pragma mark  O B J E C T
 
+    class ItemProxy;
+    struct Keyword;
+    class Interned;
+    class AttrHandle;
+
+    class ObjectIterator;
+    class SequenceRange;
+    enum class DictPart { Keys, Values, Items };
+    template< DictPart part > class DictRange;
+
     class Object
     {
     public:
@@ -135,15 +179,10 @@ namespace Py
          Only Object sets this directly, hence private
          The default constructor for Object sets it to Py_None and child classes must use "set" to set it
          Note that this is the ONLY data member of the class(!)
-         In fact it is the only data member to be found anywhere in this file!
+         (ItemProxy, which wraps container[key], carries its extra state itself -- see below)
         */
         PyObject* p{nullptr};
 
-    private:
-        void release() {
-            Py_CLEAR(p);
-        }
-
     public:
         // this is the important one, as it sets p
         // requires a CHARGED PyObject*
@@ -151,7 +190,18 @@ namespace Py
 
         // this is why we require charged pointer!
         ~Object() {
-            release();
+            discharge(p);
+        }
+
+        // Same as Object{pyob}, but says so at the call site: we take over the caller's charge
+        static Object steal( PyObject* pyob_charged ) { return Object{ pyob_charged }; }
+
+        // Hand our charge over to the caller (typically a C API function that steals, or Python itself)
+        // Leaves this Object null.
+        PyObject* release() {
+            PyObject* pyob = p;
+            p = nullptr;
+            return pyob;
         }
 
         PyObject* ptr()         const { return p; }
@@ -171,6 +221,9 @@ namespace Py
         // copy construct from another Object (neutral)
         Object( const Object& ob ) : Object{ charge(ob.p) }  { }
 
+        // move construct: take ob's charge, leaving ob null
+        Object( Object&& ob ) noexcept : Object{ ob.release() }  { }
+
         // default
         Object( ) : Object{ charge(Py_None) }  { }
 
@@ -181,12 +234,12 @@ namespace Py
     // A S S I G N M E N T
     private:
         // assume we receive charged object
+        // (discharge after assigning, in case the old object's destructor finds its way back to us)
         void set_ptr( PyObject* pyob_charged )
         {
-            if( p != pyob_charged ) {
-                if(p) release();
-                p = pyob_charged;
-            }
+            PyObject* old = p;
+            p = pyob_charged;
+            discharge(old);
         }
 
 #pragma mark  [] ELEMENT ACCESS Py{Dict,List,Set,Tuple,Bytes}_Type
@@ -195,10 +248,6 @@ namespace Py
         //    Generic functions that return object references, like PyObject_GetItem() and PySequence_GetItem(),
         //    always return a new reference (the caller becomes the owner of the reference).
 
-        mutable bool m_resolve_me{false};
-        PyObject* m_container{nullptr};
-        PyObject* m_key{nullptr};
-
     public:
         /*
          We use some artful trickery allow both Lvalue and Rvalue access for container types using []
@@ -210,6 +259,12 @@ namespace Py
          I considered and discarded the idea of overloading ->
             http://stackoverflow.com/questions/27689105/overload-operator-to-forward-member-access-through-proxy
             http://stackoverflow.com/questions/27690419/how-to-overload-operator-in-c <- here I fought a troll(!) ;)
+
+         The container & key needed for Lvalue access used to live inside Object itself,
+         which made every Object 4 words wide. They now live in ItemProxy (defined below Object),
+         so Object stays exactly one PyObject* wide.
+         ItemProxy only reads the item when it is used as a value, so a write doesn't pay for a read first;
+         that does bring back ->, for reaching the item's members: myDict["two"]->str()
          */
 
         // First case: Object[] where Object is const. This case is simple and can ONLY be Rvalue-access. e.g. 'foo = myObject[42];'
@@ -218,9 +273,7 @@ namespace Py
         }
 
         // Second case: unknown whether Lvalue or Rvalue access
-        Object operator[] (const Object& key) {
-            return Object{ *this, key };
-        }
+        ItemProxy operator[] (const Object& key);
 
         //void set_item( const Object& key, const Object& value ) {
         //    PyObject_SetItem( p, key.p, charge(value.p) );
@@ -235,77 +288,30 @@ namespace Py
         // ^ Note: C++11 guarantees null termination for std::string.c_str()
         #endif
 
-
-        Object( const Object& c, const Object& k )
-            : m_container{c.p}, m_key{k.p}, m_resolve_me{true}
-        {
-            // the next command might set Python's error indicator
-            // so let's check first to make sure the slate is clean at this point
-            // (obviously we should always do this check before performing any operation that might set the indicator)
-            throw_if_pyerr(TRACE);
-
-            // for everything except lvalue access (ob[idx]=...), ob[idx] will be valid
-            p = PyObject_GetItem( m_container, m_key ); // PyObject_GetItem returns CHARGED ptr
-            if( p == nullptr ) {
-                // ... However in the case of lvalue access, PyObject_GetItem will set Python's error indicator
-                // so we must flush that error, as it was expected!
-                PyErr_Clear();
-                p = charge(Py_None);
-            }
-            // ^ either way, p ends up charged
-        }
-
-        //void maybe_resolve() {
-        //    // e.g. obj[idx] = ...
-        //    // in that case we currently have a 'floating' object
-        //    // created by the [] operator, and initialised just setting m_container and m_key
-        //    // now we must resolve it
-        //    if( m_resolve_me ) {
-        //        PyObject* item = PyObject_GetItem( m_container, m_key );
-        //        if( item == nullptr ) throw Exception();
-        //        set_ptr(item);
-        //        m_resolve_me = false;
-        //    }
-        //}
-
     public:
         // this will attempt to convert ANY rhs to Object, which takes advantage of ALL the above constructor overrides
         Object& operator=( const Object& rhs )
         {
-            /*
-                1) normal situation
-                2) this object is m_resolve_me, and we are assigning a normal object to it
-                3) this object is m_resolve_me, and we are assigning a m_resolve_me object to it
-                4) this object is normal, and we are assigning a m_resolve_me object to it
-                
-                1) we need to charge p
-                2) same
-                3) same
-                4) same
-                
-                The only important thing is: we have to be neutral to rhs.p
-                That means we have to charge it, as we will be subsequently neutralising it in the destructor
-             */
+            // The only important thing is: we have to be neutral to rhs.p
+            // That means we have to charge it, as we will be subsequently neutralising it in the destructor
             if( &rhs != this )
                 *this = charge(rhs.p);
 
             return *this;
         }
 
+        // take over rhs's charge, leaving rhs null
+        Object& operator=( Object&& rhs ) noexcept
+        {
+            if( &rhs != this )
+                set_ptr( rhs.release() );
+
+            return *this;
+        }
+
         // (Always) assume charged pointer
         Object& operator=( PyObject* pyob )
         {
-            if( m_resolve_me ) {
-                // Yhg1s: the important fact is that PyObject_SetItem() *does not steal your references*.
-                //        The call does not affect whether you own the references to 'k' and 'v'.
-                PyObject_SetItem( m_container, m_key, pyob );
-                // ^ !!! I'm not entirely sure that PyObject_SetItem is guaranteed to incref m_key and then decref it when
-                //       either the key changes, the item is removed, or the dictionary is destroyed
-                //       note that it might not be a dictionary, it might be a list in which case m_key is the index
-                //       and should be an integer
-                m_resolve_me = false;
-            }
-
             set_ptr( pyob );
 
             return *this;
@@ -396,22 +402,111 @@ namespace Py
                  Reference for C++ integral & floatingpoint types here: http://en.cppreference.com/w/cpp/language/types
              */
 
-        // Convert to integral types
+        /*
+         Convert to integral & floatingpoint types.
+         An int (or int subclass, e.g. bool) or a float is read directly; anything else goes through
+         int(ob) / float(ob) as before, so Object{"42"} still converts.
+         A value that doesn't fit the C++ type raises OverflowError rather than being truncated.
+         */
         template<typename T, subfail_unless_integral_t<T> = 0 >
         explicit operator T() const {
-            bool small{ sizeof(T) <= sizeof(long) }, is_signed{ std::is_signed<T>::value };
+            T t;
+            if( ! extract(t) )
+                throw_if_pyerr( TRACE, "Object -> integral" );
+            return t;
+        }
+
+        explicit operator float()   const { float  t;  if( ! extract(t) ) throw_if_pyerr( TRACE, "Object -> float"  );  return t; }
+        explicit operator double()  const { double t;  if( ! extract(t) ) throw_if_pyerr( TRACE, "Object -> double" );  return t; }
+
+        #if __cplusplus >= 201703L
+        // Non-throwing version of the above: nullopt (and no pending Python error) if the conversion fails
+        template<typename T, subfail_unless_t< std::is_arithmetic<T>::value > = 0 >
+        std::optional<T> try_as() const {
+            T t;
+            if( extract(t) )
+                return t;
+            PyErr_Clear();
+            return std::nullopt;
+        }
+        #endif
+
+    private:
+        // PyLong_AsLongLong and friends work on any int subclass; other types go via int(ob)
+        // returns false with the Python error indicator set
+        template<typename T, subfail_unless_integral_t<T> = 0 >
+        bool extract( T& t ) const {
+            if( ! p ) {
+                PyErr_SetString( PyExc_TypeError, "can't convert a null Object" );
+                return false;
+            }
+
+            Object converted{ PyLong_Check(p) ? nullptr : PyObject_CallFunctionObjArgs( (PyObject*)&PyLong_Type, p, nullptr ) };
+            if( ! PyLong_Check(p) && ! converted.p )
+                return false;
+            PyObject* as_pylong = converted.p ? converted.p : p;
+
+            if( std::is_signed<T>::value ) {
+                long long v = PyLong_AsLongLong( as_pylong );
+                if( v == -1 && PyErr_Occurred() )
+                    return false;
+                return narrow( v, t );
+            }
+            else {
+                unsigned long long v = PyLong_AsUnsignedLongLong( as_pylong );
+                if( v == static_cast<unsigned long long>(-1) && PyErr_Occurred() )
+                    return false;
+                return narrow( v, t );
+            }
+        }
 
-            Object as_pylong{ convert_to(PyLong_Type) }; // ToDo: Move construct
+        template<typename T, subfail_unless_floating_t<T> = 0 >
+        bool extract( T& t ) const {
+            if( ! p ) {
+                PyErr_SetString( PyExc_TypeError, "can't convert a null Object" );
+                return false;
+            }
 
-            if(   is_signed &&   small )    return static_cast<T>( PyLong_AsLong            (as_pylong.p) );
-            if(   is_signed && ! small )    return static_cast<T>( PyLong_AsLongLong        (as_pylong.p) );
-            if( ! is_signed &&   small )    return static_cast<T>( PyLong_AsUnsignedLong    (as_pylong.p) );
-          /*if( ! is_signed && ! small )*/  return static_cast<T>( PyLong_AsUnsignedLongLong(as_pylong.p) );
+            double v;
+            if( PyFloat_CheckExact(p) )
+                v = PyFloat_AS_DOUBLE(p);
+            else if( PyLong_CheckExact(p) ) {
+                v = PyLong_AsDouble(p);
+                if( v == -1.0 && PyErr_Occurred() )
+                    return false;
+            }
+            else {
+                Object as_pyfloat{ PyObject_CallFunctionObjArgs( (PyObject*)&PyFloat_Type, p, nullptr ) };
+                if( ! as_pyfloat.p )
+                    return false;
+                v = PyFloat_AS_DOUBLE( as_pyfloat.p );
+            }
+
+            if( std::isfinite(v) && ( v > std::numeric_limits<T>::max() || v < std::numeric_limits<T>::lowest() ) ) {
+                PyErr_SetString( PyExc_OverflowError, "float too large for the C++ type" );
+                return false;
+            }
+            t = static_cast<T>(v);
+            return true;
+        }
+
+        // bool keeps its old meaning, nonzero
+        template<typename V>
+        static bool narrow( V v, bool& t ) { t = ( v != 0 );  return true; }
+
+        template<typename V, typename T>
+        static bool narrow( V v, T& t ) {
+            using W = typename std::conditional< std::is_signed<V>::value, long long, unsigned long long >::type;
+            if( static_cast<W>(v) < static_cast<W>( std::numeric_limits<T>::min() )
+               || ( v > 0 && static_cast<unsigned long long>(v) > static_cast<unsigned long long>( std::numeric_limits<T>::max() ) ) ) {
+                PyErr_SetString( PyExc_OverflowError, "int too large for the C++ type" );
+                return false;
+            }
+            t = static_cast<T>(v);
+            return true;
         }
 
-        // Convert to floatingpoint types
-        explicit operator float()   const { return static_cast<float>(   PyFloat_AsDouble(convert_to(PyFloat_Type).p)  ); }
-        explicit operator double()  const { return                       PyFloat_AsDouble(convert_to(PyFloat_Type).p)   ; }
+    public:
 
         /*
             Object{const char*} -> PyBytes_Type
@@ -437,7 +532,7 @@ namespace Py
 
         std::string dump_bytestring() const {
             Object as_bytes{ convert_to(PyBytes_Type) };
-            return std::string{ PyBytes_AsString(as_bytes.p) };
+            return std::string{ PyBytes_AS_STRING(as_bytes.p), static_cast<size_t>( PyBytes_GET_SIZE(as_bytes.p) ) };
         }
 
         std::string dump_ascii() const {
@@ -483,7 +578,49 @@ namespace Py
             return as_utf8.dump_bytestring();                       // bytes -> std::string
         }
 
-        operator std::string() const { return dump_utf8string(); }
+        // exact str/bytes are read in place (str keeps a cached UTF-8 copy of itself), with one copy into the std::string
+        operator std::string() const {
+            if( p && PyUnicode_CheckExact(p) ) {
+                Py_ssize_t n;
+                const char* utf8 = PyUnicode_AsUTF8AndSize( p, &n );
+                if( ! utf8 ) throw_if_pyerr( TRACE, "PyUnicode_AsUTF8AndSize" );
+                return std::string{ utf8, static_cast<size_t>(n) };
+            }
+            if( p && PyBytes_CheckExact(p) )
+                return std::string{ PyBytes_AS_STRING(p), static_cast<size_t>( PyBytes_GET_SIZE(p) ) };
+
+            return dump_utf8string();
+        }
+
+        #if __cplusplus >= 201703L
+        /*
+         No copy at all: a view of the UTF-8 of a str (or the raw bytes of a bytes/bytearray).
+         It points into the Python object, so it is valid only while this Object (or another reference
+         to the same object) lives, and for a bytearray only until it is resized.
+         Anything else throws; use 'std::string(ob)' for a converting read.
+         */
+        std::string_view as_string_view() const {
+            Py_ssize_t n = 0;
+            const char* data = nullptr;
+
+            if( p && PyUnicode_Check(p) ) {
+                data = PyUnicode_AsUTF8AndSize( p, &n );        // cached on the str after the first call
+                if( ! data ) throw_if_pyerr( TRACE, "PyUnicode_AsUTF8AndSize" );
+            }
+            else if( p && PyBytes_Check(p) ) {
+                data = PyBytes_AS_STRING(p);
+                n    = PyBytes_GET_SIZE(p);
+            }
+            else if( p && PyByteArray_Check(p) ) {
+                data = PyByteArray_AS_STRING(p);
+                n    = PyByteArray_GET_SIZE(p);
+            }
+            else
+                THROW( "as_string_view: needs a str, bytes or bytearray" );
+
+            return std::string_view{ data, static_cast<size_t>(n) };
+        }
+        #endif
 
         // not sure about these ones...
         #if 0
@@ -519,9 +656,151 @@ namespace Py
 #pragma mark PyFunction_Type
     public:
         // Hope PyRuntime raises an exception if we invoke this on a non-callable object
-        Object operator() ( )                                       { return Object{ charge( PyObject_CallObject           (p, nullptr       ) ) }; }
-        Object operator() ( const Object& args )                    { return Object{ charge( PyObject_CallObject           (p, args.p        ) ) }; }
-        Object operator() ( const Object& args, const Object& kwds ){ return Object{ charge( PyEval_CallObjectWithKeywords (p, args.p, kwds.p) ) }; }
+        // (these all return CHARGED pointers)
+        Object operator() ( )                                       { return Object{ PyObject_CallObject           (p, nullptr       ) }; }
+        Object operator() ( const Object& args )                    { return Object{ PyObject_CallObject           (p, args.p        ) }; }
+        Object operator() ( const Object& args, const Object& kwds ){ return Object{ PyObject_Call                 (p, args.p, kwds.p) }; }
+
+        /*
+         Call with C++ arguments directly, without building an args tuple (or kwargs dict):
+            f.call( 1, "two", some_object );
+            f.call( 1, kw("base", 16) );                // keyword arguments come last, as in Python
+            ob.call_method( "append", 42 );            // ob.append(42), without creating a bound method
+
+         Each argument becomes an Object in a stack array, which goes straight to the vectorcall protocol
+         (PyObject_Vectorcall / PyObject_VectorcallMethod), keyword values riding at the end of the array
+         with their names in a kwnames tuple. Before Python 3.9 we fall back to building the tuple and dict.
+
+         Unlike operator(), these throw if the call raises.
+         */
+        template<typename ... Arg>
+        Object call( Arg&& ... arg ) const
+        {
+            static_assert( keywords_trail<Arg...>(), "call(): keyword arguments must come after positional ones" );
+            constexpr size_t N = sizeof...(Arg);
+
+            Object kwnames{ build_kwnames( std::forward<Arg>(arg) ... ) };
+
+            // slot 0 is left free so the callee may borrow it (PY_VECTORCALL_ARGUMENTS_OFFSET)
+            Object stack[ 1+N ] = { Object{ (PyObject*)nullptr }, slot_value( std::forward<Arg>(arg) ) ... };
+
+            return vectorcall( p, stack+1, N - count_keywords<Arg...>(), kwnames.p, true );
+        }
+
+        template<typename ... Arg>
+        Object call_method( const Object& name, Arg&& ... arg ) const
+        {
+            static_assert( keywords_trail<Arg...>(), "call_method(): keyword arguments must come after positional ones" );
+            constexpr size_t N = sizeof...(Arg);
+
+            Object kwnames{ build_kwnames( std::forward<Arg>(arg) ... ) };
+
+            // slot 0 is self; it is only lent to the array (no charge), and taken back straight after the call
+            Object stack[ 1+N ] = { Object{ (PyObject*)nullptr }, slot_value( std::forward<Arg>(arg) ) ... };
+            stack[0].p = p;
+
+            PyObject* result = vectorcall_method( name.p, stack, 1 + N - count_keywords<Arg...>(), kwnames.p );
+            stack[0].p = nullptr;
+
+            ENSURE_OK( result );
+            return Object{ result };
+        }
+
+    private:
+        template<typename T>
+        static constexpr bool is_keyword() { return std::is_same< decay_t<T>, Keyword >::value; }
+
+        // (C++11 constexpr: recurse over the pack through a helper struct)
+        template<typename ... Arg> struct Keywords;
+
+        template<typename ... Arg>
+        static constexpr size_t count_keywords() { return Keywords<Arg...>::count; }
+
+        template<typename ... Arg>
+        static constexpr bool keywords_trail() { return Keywords<Arg...>::trail; }
+
+        template<typename T, subfail_unless_t< ! is_keyword<T>() > = 0 >
+        static Object slot_value( T&& t )       { return Object{ std::forward<T>(t) }; }
+
+        template<typename T, subfail_unless_t<   is_keyword<T>() > = 0 >
+        static Object slot_value( T&& k )       { return std::forward<T>(k).value; }
+
+        template<typename T, subfail_unless_t< ! is_keyword<T>() > = 0 >
+        static void add_kwname( PyObject* , Py_ssize_t& , const T& )  { }
+
+        template<typename T, subfail_unless_t<   is_keyword<T>() > = 0 >
+        static void add_kwname( PyObject* kwnames, Py_ssize_t& j, const T& k ) { PyTuple_SET_ITEM( kwnames, j++, charge(k.name.p) ); }
+
+        // CHARGED tuple of the keyword names, or nullptr if there are no keyword arguments
+        static PyObject* build_kwnames() { return nullptr; }
+
+        template<typename ... Arg>
+        static PyObject* build_kwnames( const Arg& ... arg )
+        {
+            constexpr size_t K = count_keywords<Arg...>();
+            if( K == 0 )
+                return nullptr;
+
+            PyObject* kwnames = PyTuple_New(K);
+            ENSURE_OK( kwnames );
+            Py_ssize_t j = 0;           // the next item of kwnames
+            int expand[] = { ( add_kwname( kwnames, j, arg ), 0 ) ... };
+            (void)expand;
+            return kwnames;
+        }
+
+        // args[0 .. nargs) positional, followed by one value per name in kwnames
+        static Object vectorcall( PyObject* callable, Object* args, size_t nargs, PyObject* kwnames, bool offset_slot_free )
+        {
+            PyObject* result = vectorcall_raw( callable, args, nargs, kwnames, offset_slot_free );
+            ENSURE_OK( result );
+            return Object{ result };
+        }
+
+        // returns CHARGED ptr, or nullptr with the error indicator set
+        static PyObject* vectorcall_raw( PyObject* callable, Object* args, size_t nargs, PyObject* kwnames, bool offset_slot_free = false )
+        {
+            PyObject** stack = reinterpret_cast<PyObject**>(args);
+            #if PY_VERSION_HEX >= 0x03090000
+            return PyObject_Vectorcall( callable, stack, nargs | (offset_slot_free ? PY_VECTORCALL_ARGUMENTS_OFFSET : 0), kwnames );
+            #else
+            (void)offset_slot_free;
+            return call_with_tuple( callable, stack, nargs, kwnames );
+            #endif
+        }
+
+        // returns CHARGED ptr, or nullptr with the error indicator set
+        static PyObject* vectorcall_method( PyObject* name, Object* args, size_t nargs, PyObject* kwnames )
+        {
+            PyObject** stack = reinterpret_cast<PyObject**>(args);
+            #if PY_VERSION_HEX >= 0x03090000
+            return PyObject_VectorcallMethod( name, stack, nargs, kwnames );
+            #else
+            Object method{ PyObject_GetAttr( stack[0], name ) };
+            return method.p ? call_with_tuple( method.p, stack+1, nargs-1, kwnames ) : nullptr;
+            #endif
+        }
+
+        // the pre-vectorcall route: pack the array into an args tuple and a kwargs dict
+        static PyObject* call_with_tuple( PyObject* callable, PyObject** stack, size_t nargs, PyObject* kwnames )
+        {
+            Object args{ PyTuple_New( static_cast<Py_ssize_t>(nargs) ) };
+            if( ! args.p ) return nullptr;
+            for( size_t i=0; i < nargs; i++ )
+                PyTuple_SET_ITEM( args.p, i, charge(stack[i]) );
+
+            Object kwargs{ kwnames ? PyDict_New() : nullptr };
+            if( kwnames ) {
+                if( ! kwargs.p ) return nullptr;
+                for( Py_ssize_t j=0; j < PyTuple_GET_SIZE(kwnames); j++ )
+                    if( PyDict_SetItem( kwargs.p, PyTuple_GET_ITEM(kwnames, j), stack[nargs+j] ) < 0 )
+                        return nullptr;
+            }
+
+            return PyObject_Call( callable, args.p, kwargs.p );
+        }
+
+    public:
 
 
 #pragma mark PARAM PACKS FOR LIST DICT ETC
@@ -529,67 +808,127 @@ namespace Py
         // http://stackoverflow.com/questions/27418626/using-double-braces-e-g-fooinitializer-list-to-resolve-ambiguity
         // http://stackoverflow.com/questions/27500944/appropriate-syntax-for-initialising-python-c-api-container-types-list-dict-tupl
 
+        // The arity is known at compile time, so each container is allocated at its final size
+        // and filled in place -- no intermediate list, no conversion.
+        // Each argument becomes an Object first (so PyObject* arguments must be CHARGED, as ever);
+        // tuple and list slots then steal that charge.
+
+    private:
+        struct TupleSlots { static void set( PyObject* c, Py_ssize_t i, PyObject* v ) { PyTuple_SET_ITEM( c, i, v ); } };
+        struct ListSlots  { static void set( PyObject* c, Py_ssize_t i, PyObject* v ) { PyList_SET_ITEM ( c, i, v ); } };
+
+        template<typename Slots>
+        static void fill_slots( PyObject* , Py_ssize_t )  { } // recursion terminator
+
+        template<typename Slots, typename Foo, typename ... More>
+        static void fill_slots( PyObject* container, Py_ssize_t i, Foo&& foo, More&& ... more ) {
+            Slots::set( container, i, Object{ std::forward<Foo>(foo) }.release() ); // SET_ITEM steals
+            fill_slots<Slots>( container, i+1, std::forward<More>(more) ... );
+        }
+
+        static void fill_set( PyObject* )  { }
+
         template<typename Foo, typename ... More>
-        void unpack_to_list( Object& list, Foo&& foo, More&& ... more ) {
-            // PyList_Append does not "steal" a reference, i.e. it expects a neutral pointer
-            Object ob{foo};
-            //COUT(ob);
-            PyList_Append( list.p, ob.p ); // PyList_Append INCREFs
-            unpack_to_list( list, std::forward<More>(more) ... );
+        static void fill_set( PyObject* set, Foo&& foo, More&& ... more ) {
+            ENSURE_OK( PySet_Add( set, Object{ std::forward<Foo>(foo) }.p ) ); // PySet_Add INCREFs
+            fill_set( set, std::forward<More>(more) ... );
         }
 
-        void unpack_to_list( Object& list )  { } // recursion terminator
+        static void fill_dict( PyObject* )  { }
 
-        //template< Car car, Cdr ... cdr >
+        template<typename K>
+        static void fill_dict( PyObject* , K&& ) {
+            THROW( "Must supply an even number of arguments to dictionary" );
+        }
+
+        template<typename K, typename V, typename ... More>
+        static void fill_dict( PyObject* dict, K&& k, V&& v, More&& ... more ) {
+            ENSURE_OK( PyDict_SetItem( dict, Object{ std::forward<K>(k) }.p, Object{ std::forward<V>(v) }.p ) ); // PyDict_SetItem INCREFs k&v
+            fill_dict( dict, std::forward<More>(more) ... );
+        }
+
+        static PyObject* new_dict( Py_ssize_t n_pairs ) {
+            #ifndef Py_LIMITED_API
+            return _PyDict_NewPresized( n_pairs );
+            #else
+            return PyDict_New();
+            #endif
+        }
+
+        static PyObject* convert_first( PyTypeObject& _type ) {
+            // no argument: whatever calling the type with no arguments gives, e.g. bytes() -> b''
+            return PyObject_CallObject( reinterpret_cast<PyObject*>(&_type), nullptr );
+        }
+
+        template<typename Foo, typename ... More>
+        static PyObject* convert_first( PyTypeObject& _type, Foo&& foo, More&& ... ) {
+            return Object{ std::forward<Foo>(foo) }.convert_to(_type).release();
+        }
+
+        // return CHARGED pointer
         template<typename ... Arg>
-        Object( PyTypeObject& _type, Arg&& ... arg )
+        static PyObject* build( PyTypeObject& _type, Arg&& ... arg )
         {
-            throw_if_pyerr(TRACE);
-            Object list{ PyList_New(0) };
-            unpack_to_list( list, std::forward<Arg>(arg) ... );
-            Py_ssize_t N = PyObject_Length( list.p );
-
-            if( &_type == &PyDict_Type )
-            {
-                if( N % 2 != 0 ) throw Exception{ "Must supply an even number of arguments to dictionary" };
-
-                Object dict{ PyDict_New() };
-
-                int i=0;
-                while( i < N ) {
-                    auto k = list[i++].p;
-                    auto v = list[i++].p;
-                    PyDict_SetItem( dict.p, k, v ); // PyDict_SetItem INCREFs k&v
-                    //PyObject_SetItem( dict.p, list[i++].p, list[i++].p );
-                }
+            constexpr Py_ssize_t N = sizeof...(Arg);
+
+            Object result{ (PyObject*)nullptr };
 
-                *this = dict;
+            if( &_type == &PyTuple_Type ) {
+                result = PyTuple_New(N);
+                ENSURE_OK( result.p );
+                fill_slots<TupleSlots>( result.p, 0, std::forward<Arg>(arg) ... );
             }
 
-            else if(
-                    & _type == & PyList_Type
-                 || & _type == & PyTuple_Type
-                 || & _type == & PySet_Type    )
-            {
-                *this = list.convert_to(_type);
+            else if( &_type == &PyList_Type ) {
+                result = PyList_New(N);
+                ENSURE_OK( result.p );
+                fill_slots<ListSlots>( result.p, 0, std::forward<Arg>(arg) ... );
+            }
+
+            else if( &_type == &PyDict_Type ) {
+                if( N % 2 != 0 ) THROW( "Must supply an even number of arguments to dictionary" );
+                result = new_dict( N/2 );
+                ENSURE_OK( result.p );
+                fill_dict( result.p, std::forward<Arg>(arg) ... );
+            }
+
+            else if( &_type == &PySet_Type ) {
+                result = PySet_New( nullptr );
+                ENSURE_OK( result.p );
+                fill_set( result.p, std::forward<Arg>(arg) ... );
             }
 
             else {
-                Object obj( list[0] );
-                *this = obj.convert_to(_type);
+                // e.g. Object{ PyBytes_Type, "bar" } or Object{ PyComplex_Type, "3+4j" }: convert the (first) argument
+                result = convert_first( _type, std::forward<Arg>(arg) ... );
+                ENSURE_OK( result.p );
+            }
+
+            return result.release();
+        }
+
+        static PyTypeObject& container_type( const char c ) {
+            switch( c ) {
+                case 'L': return PyList_Type;
+                case 'T': return PyTuple_Type;
+                case 'S': return PySet_Type;
+                case 'D': return PyDict_Type;
+                case 'B': return PyBytes_Type;
             }
+            THROW( std::string{"Object( c, ... ): unknown container code '"} + c + "', expected one of L T S D B" );
         }
 
+    public:
+        template<typename ... Arg>
+        Object( PyTypeObject& _type, Arg&& ... arg )
+            : Object{ build( _type, std::forward<Arg>(arg) ... ) }
+        { }
+
         // make this explicit, we don't want this constructor to be considered for implicit typecasts
         template<typename ... Arg>
         explicit Object( const char c, Arg&& ... arg )
-        {
-            if( c=='L' ) *this = Object{  PyList_Type, std::forward<Arg>(arg) ... };
-            if( c=='T' ) *this = Object{ PyTuple_Type, std::forward<Arg>(arg) ... };
-            if( c=='S' ) *this = Object{   PySet_Type, std::forward<Arg>(arg) ... };
-            if( c=='D' ) *this = Object{  PyDict_Type, std::forward<Arg>(arg) ... };
-            if( c=='B' ) *this = Object{ PyBytes_Type, std::forward<Arg>(arg) ... };
-        }
+            : Object{ build( container_type(c), std::forward<Arg>(arg) ... ) }
+        { }
 
         void append( const Object& ob ) {
             PyList_Append( p, ob.p ); // assume it doesn't steal reference. So it requires neutral pointer. ??? Answer // PyList_Append INCREFs, so yes!
@@ -617,6 +956,13 @@ namespace Py
         template< typename T, typename U>
         using subfail_if_neither_is_object_t = subfail_unless_t< is_object<T>() || is_object<U>() >;
 
+        // Operands that already are Objects get passed straight through by reference;
+        // only foreign types (int, double, const char* ...) need converting into a temporary Object
+        static const Object& operand( const Object& t ) { return t; }
+
+        template< typename T, subfail_unless_t< ! is_object<T>() > = 0 >
+        static Object operand( const T& t ) { return Object{t}; }
+
         using OpFunc = decltype(PyNumber_Add);
         static Object do_op( OpFunc& op_func, const Object& t, const Object& u ) {
             PyObject* ret{ op_func( t.p, u.p ) };
@@ -629,11 +975,11 @@ namespace Py
         #define TEMPLATE_TU \
             template < typename T,  typename U,  subfail_if_neither_is_object_t<T,U> = 0 >
 
-        TEMPLATE_TU friend Object operator + ( const T& t, const U& u ) { return do_op( PyNumber_Add        , Object{t}, Object{u} ); }
-        TEMPLATE_TU friend Object operator - ( const T& t, const U& u ) { return do_op( PyNumber_Subtract   , Object{t}, Object{u} ); }
-        TEMPLATE_TU friend Object operator * ( const T& t, const U& u ) { return do_op( PyNumber_Multiply   , Object{t}, Object{u} ); }
-        TEMPLATE_TU friend Object operator / ( const T& t, const U& u ) { return do_op( PyNumber_TrueDivide , Object{t}, Object{u} ); }
-        TEMPLATE_TU friend Object operator % ( const T& t, const U& u ) { return do_op( PyNumber_Remainder  , Object{t}, Object{u} ); }
+        TEMPLATE_TU friend Object operator + ( const T& t, const U& u ) { return do_op( PyNumber_Add        , operand(t), operand(u) ); }
+        TEMPLATE_TU friend Object operator - ( const T& t, const U& u ) { return do_op( PyNumber_Subtract   , operand(t), operand(u) ); }
+        TEMPLATE_TU friend Object operator * ( const T& t, const U& u ) { return do_op( PyNumber_Multiply   , operand(t), operand(u) ); }
+        TEMPLATE_TU friend Object operator / ( const T& t, const U& u ) { return do_op( PyNumber_TrueDivide , operand(t), operand(u) ); }
+        TEMPLATE_TU friend Object operator % ( const T& t, const U& u ) { return do_op( PyNumber_Remainder  , operand(t), operand(u) ); }
 
         static bool do_cmp( const Object& t, const Object& u, int cmp ) {
             bool ret = PyObject_RichCompareBool( t.p, u.p, cmp );
@@ -642,12 +988,12 @@ namespace Py
             return ret;
         }
 
-        TEMPLATE_TU friend bool operator == (  const T& t, const U& u ) { return do_cmp( Object{t}, Object{u}, Py_EQ ); }
-        TEMPLATE_TU friend bool operator != (  const T& t, const U& u ) { return do_cmp( Object{t}, Object{u}, Py_NE ); }
-        TEMPLATE_TU friend bool operator >  (  const T& t, const U& u ) { return do_cmp( Object{t}, Object{u}, Py_GT ); }
-        TEMPLATE_TU friend bool operator <  (  const T& t, const U& u ) { return do_cmp( Object{t}, Object{u}, Py_LT ); }
-        TEMPLATE_TU friend bool operator >= (  const T& t, const U& u ) { return do_cmp( Object{t}, Object{u}, Py_GE ); }
-        TEMPLATE_TU friend bool operator <= (  const T& t, const U& u ) { return do_cmp( Object{t}, Object{u}, Py_LE ); }
+        TEMPLATE_TU friend bool operator == (  const T& t, const U& u ) { return do_cmp( operand(t), operand(u), Py_EQ ); }
+        TEMPLATE_TU friend bool operator != (  const T& t, const U& u ) { return do_cmp( operand(t), operand(u), Py_NE ); }
+        TEMPLATE_TU friend bool operator >  (  const T& t, const U& u ) { return do_cmp( operand(t), operand(u), Py_GT ); }
+        TEMPLATE_TU friend bool operator <  (  const T& t, const U& u ) { return do_cmp( operand(t), operand(u), Py_LT ); }
+        TEMPLATE_TU friend bool operator >= (  const T& t, const U& u ) { return do_cmp( operand(t), operand(u), Py_GE ); }
+        TEMPLATE_TU friend bool operator <= (  const T& t, const U& u ) { return do_cmp( operand(t), operand(u), Py_LE ); }
 
         Object do_ip( OpFunc& op_func, const Object& u ) {
             Object ret = op_func(p, u.p);
@@ -704,7 +1050,13 @@ namespace Py
 
 
         bool   hasAttr( const std::string& s )  const { return         PyObject_HasAttrString(p,const_cast<char*>(s.c_str())) ? true : false; }
-        Object getAttr( const std::string& s )  const { return charge( PyObject_GetAttrString(p,const_cast<char*>(s.c_str())) ); }
+        Object getAttr( const std::string& s )  const { return         PyObject_GetAttrString(p,const_cast<char*>(s.c_str()))  ; }
+
+        // via an interned name ("x"_py, or an AttrHandle): no fresh str on every access
+        bool   hasAttr( const Interned& h )     const;
+        Object getAttr( const Interned& h )     const;
+        void   setAttr( const Interned& h, const Object& value );
+        void   delAttr( const Interned& h );
 
         Object getItem( const Object& key )     const { return PyObject_GetItem(p,*key); }
 
@@ -772,79 +1124,693 @@ namespace Py
       The problem of trying to have a generic Object class is that we can't really support Map and Vector
       functionality together. Because each container has its own different iterators.
         http://stackoverflow.com/questions/27726181/hybrid-listdict-container-in-c11
-      I've opted for just supporting a Vector type container
-      This allows fast-enumerating through myMapObj.keys()
-      It does mean that we can't throw an Object containing a PyDict_Type through any of
-      stdlib's Map processing algorithms. If anyone wants that, they would probably have to design
-      a Dict : Object, and then maybe work out whether this machinery conflicts with the new machinery
-      they would have to write etc.
+
+      So begin()/end() iterate the way Python's 'for x in ob' would, picking the cheapest route for ob's exact type:
+        - list, tuple:  walk the item array in place (borrowed, no PyLong boxing, no PyObject_GetItem)
+        - dict:         walk the keys with PyDict_Next (no keys() list is built)
+        - anything else: PyObject_GetIter / PyIter_Next
+      It is tagged an input iterator, as the last case is single-pass: copies of it share one Python iterator,
+      so std::max_element and the like, which go back to a position they kept, would read the wrong items.
+
+      Where you want more than that, ask for it explicitly (iterators are defined below Object):
+        as_sequence()                           random-access over a list/tuple's items (anything else iterable is
+                                                first copied into a list, as PySequence_Fast does)
+        iter_keys(), iter_values(), iter_items() PyDict_Next over an exact dict, items() yielding (key,value) pairs,
+                                                forward (multi-pass)
+
+      Items are handed out as 'const Object&' borrowed from the container, so it must not be resized while iterating.
      */
 
+    public:
+        using value_type      = Object;
+        using reference       = const Object&;
+        using const_reference = const Object&;
+        using difference_type = ptrdiff_t;
+        using size_type       = Py_ssize_t;
+        using iterator        = ObjectIterator;
+        using const_iterator  = ObjectIterator;
+
+        Py_ssize_t              length()        const { return PyObject_Length(p); }  // was PySequence_Length
+        Py_ssize_t              size()          const { return PyObject_Length(p); }  // was PySequence_Length
+        Py_ssize_t              max_size()      const { return std::numeric_limits<Py_ssize_t>::max(); }
+        bool                    empty()         const { return length()==0; }
+
+        void        swap( Object& o )                 { std::swap( p, o.p ); }
+        friend void swap( Object& a, Object& b )      { a.swap(b); }
+
+        iterator                begin()         const;
+        iterator                end()           const;
+
+        const_iterator          cbegin()        const;
+        const_iterator          cend()          const;
+
+        SequenceRange                   as_sequence()   const;
+        DictRange<DictPart::Keys>       iter_keys()     const;
+        DictRange<DictPart::Values>     iter_values()   const;
+        DictRange<DictPart::Items>      iter_items()    const;
+
+    }; // End of class Object
+
+    // Object must remain a bare PyObject* so that containers of Objects pack tightly
+    static_assert( sizeof(Object) == sizeof(PyObject*), "Object must be exactly one PyObject* wide" );
+
+
+#pragma mark  I T E M   P R O X Y
+
+    /*
+     ItemProxy is what the non-const Object::operator[] hands back.
+
+     It remembers the container and key, and nothing else: assigning to it writes straight through,
+     with no read first (PyDict_SetItem for an exact dict, PyObject_SetItem otherwise):
+            myList[1] = 42;                   // PyObject_SetItem( myList, 1, 42 )
+            myList[1] = myDict["two"];        // ditto, with the value of myDict["two"]
+            myDict["a"]["b"] = 3;             // reads myDict["a"], writes its ["b"]
+
+     The read happens when the proxy is used as a value: converted to an Object, cast, compared or
+     operated on, called, or reached through with ->:
+            Object x = myDict["two"];
+            int n = static_cast<int>( myList[1] );
+            myDict["two"]->str();
+
+     A missing item reads as None. The read doesn't raise for that (an error already pending does throw):
+        - exact dict:               PyDict_GetItemWithError, which reports a missing key without raising
+        - exact list/tuple, int:    bounds-checked direct read of the item array
+        - anything else:            PyObject_GetItem, clearing the KeyError/IndexError it raised
+
+     Only a temporary proxy can be assigned to. 'auto x = myDict["two"]' makes x a proxy, not a value,
+     and 'x = 3' would be a write into myDict; it doesn't compile (write 'Object x = ...' for the value).
+     */
+    class ItemProxy
+    {
+    private:
+        Object m_container;
+        Object m_key;
+
+        // returns CHARGED ptr to c[k], or to None if there is no such item
+        static PyObject* get_or_none( PyObject* c, PyObject* k )
+        {
+            // any error now is ours to clear below: one that was already pending is thrown instead
+            throw_if_pyerr(TRACE);
+
+            PyObject* item{ nullptr };
+
+            if( PyDict_CheckExact(c) )
+                item = charge( PyDict_GetItemWithError( c, k ) ); // borrowed, nullptr for a missing key
+
+            else if( ( PyList_CheckExact(c) || PyTuple_CheckExact(c) ) && PyLong_CheckExact(k) ) {
+                Py_ssize_t N = PySequence_Fast_GET_SIZE(c);
+                Py_ssize_t i = PyLong_AsSsize_t(k);
+                bool overflow = i == -1 && PyErr_Occurred();   // a huge index: no such item, rather than the last one
+                if( i < 0 ) i += N;
+                if( ! overflow && 0 <= i && i < N )
+                    item = charge( PySequence_Fast_GET_ITEM( c, i ) ); // borrowed
+            }
+
+            else
+                item = PyObject_GetItem( c, k ); // PyObject_GetItem returns CHARGED ptr
+
+            if( item == nullptr ) {
+                PyErr_Clear();      // the lookup's own KeyError / IndexError / OverflowError
+                item = charge(Py_None);
+            }
+            return item;
+        }
+
+        void set_item( PyObject* value ) const
+        {
+            // Yhg1s: the important fact is that PyObject_SetItem() *does not steal your references*.
+            //        The call does not affect whether you own the references to 'k' and 'v'.
+            int ret = PyDict_CheckExact(m_container.p) ? PyDict_SetItem  ( m_container.p, m_key.p, value )
+                                                       : PyObject_SetItem( m_container.p, m_key.p, value );
+            ENSURE_OK( ret );
+        }
+
+        // what -> hands out: the value, kept alive until the end of the full expression
+        struct Arrow
+        {
+            Object value;
+            Object* operator->() { return &value; }
+        };
+
+    public:
+        ItemProxy( const Object& c, const Object& k ) : m_container{c}, m_key{k}  { }
+
+        ItemProxy( const ItemProxy& ) = default;
+
+        // R E A D
+
+        Object value() const        { return Object{ get_or_none( m_container.p, m_key.p ) }; }
+        operator Object() const     { return value(); }
+
+        // static_cast<int>( d["k"] ), std::string( d["k"] ) ...: whatever Object converts to
+        template<typename T, subfail_unless_t< ! std::is_same<T,Object>::value > = 0 >
+        explicit operator T() const { return static_cast<T>( value() ); }
+
+        Arrow operator->() const    { return Arrow{ value() }; }
+
+        ItemProxy operator[]( const Object& key ) const  { return ItemProxy{ value(), key }; }
+
+        template<typename ... Arg>
+        Object operator()( Arg&& ... arg ) const  { return value()( std::forward<Arg>(arg) ... ); }
+
+        // W R I T E   (only to a temporary: see above)
+
+        ItemProxy& operator=( const Object& rhs ) &&    { set_item( rhs.p );  return *this; }
+
+        // myList[1] = myDict["two"] -- assign the VALUE of the rhs proxy, not its container/key
+        ItemProxy& operator=( const ItemProxy& rhs ) && { set_item( rhs.value().p );  return *this; }
+
+        const Object& container() const { return m_container; }
+        const Object& key()       const { return m_key; }
+
+        // arithmetic and comparisons read the item, then are Object's (see O P E R A T O R S)
+        #define PROXY_OP( op ) \
+            template<typename U> \
+            friend auto operator op ( const ItemProxy& t, const U& u ) -> decltype( t.value() op u ) { return t.value() op u; } \
+            template<typename T, subfail_unless_t< ! std::is_same<T,ItemProxy>::value > = 0 > \
+            friend auto operator op ( const T& t, const ItemProxy& u ) -> decltype( t op u.value() ) { return t op u.value(); }
+
+        PROXY_OP( + )   PROXY_OP( - )   PROXY_OP( * )   PROXY_OP( / )   PROXY_OP( % )
+        PROXY_OP( == )  PROXY_OP( != )  PROXY_OP( > )   PROXY_OP( < )   PROXY_OP( >= )  PROXY_OP( <= )
+        #undef PROXY_OP
+
+        friend std::ostream& operator << ( std::ostream& outstream, const ItemProxy& item ) { return outstream << item.value(); }
+    };
+
+    inline ItemProxy Object::operator[] (const Object& key) {
+        return ItemProxy{ *this, key };
+    }
+
+
+#pragma mark  K E Y W O R D   A R G U M E N T S
+
+    // One keyword argument for Object::call / call_method, made with kw(): f.call( 1, kw("base", 16) )
+    struct Keyword
+    {
+        Object name;    // interned str
+        Object value;
+    };
+
+    template<>
+    struct Object::Keywords<> {
+        static constexpr size_t count = 0;
+        static constexpr bool   trail = true;
+    };
+
+    template<typename A, typename ... More>
+    struct Object::Keywords<A, More...> {
+        static constexpr bool   is_kw = Object::is_keyword<A>();
+        static constexpr size_t count = (is_kw ? 1 : 0) + Keywords<More...>::count;
+        static constexpr bool   trail = is_kw ? Keywords<More...>::count == sizeof...(More) : Keywords<More...>::trail;
+    };
+
+    template<typename T>
+    inline Keyword kw( const char* name, T&& value ) {
+        return Keyword{ Object{ PyUnicode_InternFromString(name) }, Object{ std::forward<T>(value) } };
+    }
+
+
+#pragma mark  B O R R O W E D
+
+    /*
+     Borrowed is a non-owning view of a PyObject: it never charges or discharges.
+
+     Use it where we are handed a neutral pointer (e.g. the args Python passes into a handler)
+     and only need to read it for the duration of a call. Because Object is exactly one PyObject*,
+     Borrowed can present itself as a 'const Object&' without touching the refcount:
+
+            void f( const Object& args );
+            f( Borrowed{args_from_python} );        // no INCREF/DECREF pair
+
+     The viewed object must outlive the Borrowed. Take a copy (Object{borrowed}) to keep it.
+     */
+    class Borrowed
+    {
     private:
-        // Was deriving from: public std::iterator< std::random_access_iterator_tag, Object >
-        // Now we do that manually
-        template< bool isConst >
-        class iterator_base
+        // an Object whose destructor is never run, so it never discharges
+        union View {
+            Object ob;
+            View( PyObject* pyob ) : ob{pyob} { }
+            ~View() { }
+        } m_view;
+
+    public:
+        Borrowed( PyObject* pyob )      : m_view{ pyob }  { }
+        Borrowed( const Object& ob )    : m_view{ ob.p }  { }
+
+        Borrowed( const Borrowed& b )   : m_view{ b.ptr() }  { }
+        Borrowed& operator=( const Borrowed& b ) { m_view.ob.p = b.ptr();  return *this; }
+
+        PyObject*     ptr()         const { return m_view.ob.p; }
+        PyObject*     operator * () const { return m_view.ob.p; }
+
+        const Object& object()      const { return m_view.ob; }
+        operator const Object& ()   const { return m_view.ob; }
+    };
+
+#pragma mark  H A N D L E S
+
+    // the interpreter the calling thread is in (PyInterpreterState_Get is 3.9+)
+    inline PyInterpreterState* this_interpreter()
+    {
+#if PY_VERSION_HEX >= 0x03090000
+        return PyInterpreterState_Get();
+#else
+        return PyThreadState_Get()->interp;
+#endif
+    }
+
+    // the dict an interpreter keeps for extensions' state, borrowed (PyInterpreterState_GetDict is 3.8+: before that, its sys dict)
+    inline PyObject* interpreter_dict( PyInterpreterState* interp )
+    {
+#if PY_VERSION_HEX >= 0x03080000
+        return PyInterpreterState_GetDict( interp );
+#else
+        return interp->sysdict;
+#endif
+    }
+
+    /*
+     The Python objects πcxx makes once per interpreter and then reuses (interned names, parameter defaults),
+     each in a slot: a process-wide number that indexes every interpreter's table.
+     The table lives in the interpreter's dict and lets go of its objects when the interpreter goes,
+     so nothing made in one interpreter is handed to another, nor outlives its runtime.
+
+     A Slot is held by whatever the object is for (an Interned, a ParamTable entry) and gives its number back
+     when that goes, for the next one to take: registering again doesn't grow the tables.
+     Each taking is a new generation, so a table entry left by the number's previous holder is made again, not reused.
+     */
+    class InterpreterObjects
+    {
+    public:
+        class Slot
         {
         private:
-            using pointer           = Object*;
-            using iterator_category = std::random_access_iterator_tag;
+            friend class InterpreterObjects;
+            size_t  m_index;
+            size_t  m_generation;       // 0 once moved from
+
+        public:
+            Slot() {
+                Numbers& n = numbers();
+                std::lock_guard<std::mutex> lock{ n.mutex };
+                m_generation = ++n.generation;
+                if( n.free.empty() )
+                    m_index = n.next++;
+                else {
+                    m_index = n.free.back();
+                    n.free.pop_back();
+                }
+            }
 
-            using value_type      = Object;
-            using reference       = value_type&;
-            using difference_type = ptrdiff_t;
+            Slot( Slot&& s ) noexcept : m_index{ s.m_index }, m_generation{ s.m_generation }  { s.m_generation = 0; }
+
+            Slot( const Slot& ) = delete;
+            Slot& operator=( const Slot& ) = delete;
+
+            ~Slot() {
+                if( ! m_generation )
+                    return;
+                Numbers& n = numbers();
+                std::lock_guard<std::mutex> lock{ n.mutex };
+                n.free.push_back( m_index );
+            }
+        };
 
-            friend class Object; // allow Object to see our data
+    private:
+        struct Made {
+            Object  object{ (PyObject*)nullptr };
+            size_t  generation{ 0 };        // of the Slot it was made for
+        };
+        std::deque<Made>    m_made;         // by slot number
 
-            using I = iterator_base<isConst>;
+        static constexpr const char* key = "picxx.objects";
 
-            template <typename T>
-            using MaybeConst = typename std::conditional< isConst, const T, T >::type;
+        struct Numbers {
+            std::mutex              mutex;
+            std::vector<size_t>     free;
+            size_t                  next{ 0 };
+            size_t                  generation{ 0 };
+        };
+        // never destroyed: a static Slot may go after it otherwise
+        static Numbers& numbers() { static Numbers* n = new Numbers;  return *n; }
 
-            const Object&       m_ob;
-            Py_ssize_t          m_index;
+    public:
+        // goes up whenever an interpreter's table goes, so a table cached per thread can be checked before use
+        static std::atomic<size_t>& epoch() { static std::atomic<size_t> e{ 0 };  return e; }
 
-        public:
-            iterator_base( const Object& ob, Py_ssize_t index ) : m_index{index}, m_ob{ ob }  { }
+        // the current interpreter's
+        static InterpreterObjects& current()
+        {
+            struct Cached { PyInterpreterState* interp;  size_t epoch;  InterpreterObjects* table; };
+            static thread_local Cached cached{ nullptr, 0, nullptr };
 
-            MaybeConst<I&> operator++() { m_index++; return *this; }
+            PyInterpreterState* interp = this_interpreter();
+            if( cached.table && cached.interp == interp && cached.epoch == epoch() )
+                return *cached.table;
 
-            MaybeConst<I> operator++( int ) { I iter{ m_ob, m_index }; m_index++; return iter; }
+            PyObject* dict = interpreter_dict( interp );     // borrowed
+            if( ! dict )
+                THROW( "InterpreterObjects: no interpreter dict" );
 
-            friend bool operator == ( const I& lhs, const I& rhs )  { return *lhs.m_ob == *rhs.m_ob  &&  lhs.m_index == rhs.m_index; };
-            friend bool operator != ( const I& lhs, const I& rhs )  { return !(lhs == rhs); };
+            InterpreterObjects* table;
+            if( PyObject* capsule = PyDict_GetItemString( dict, key ) )
+                table = static_cast<InterpreterObjects*>( PyCapsule_GetPointer( capsule, key ) );
+            else {
+                table = new InterpreterObjects;
+                Object made{ PyCapsule_New( table, key, [] (PyObject* c) { delete static_cast<InterpreterObjects*>( PyCapsule_GetPointer( c, key ) ); } ) };
+                if( ! made.p ) {
+                    delete table;
+                    throw_if_pyerr(TRACE);
+                }
+                if( PyDict_SetItemString( dict, key, made.p ) < 0 )
+                    throw_if_pyerr(TRACE);
+            }
+            cached = Cached{ interp, epoch(), table };
+            return *table;
+        }
 
-            MaybeConst<Object> operator*()  const {
-                return m_ob[m_index];
+        // the object for 'slot', made by make() (a new reference, or nullptr with the error set) the first time.
+        // (a deque: an object handed out stays where it is while the table grows)
+        template< typename Make >
+        const Object& get( const Slot& slot, Make&& make )
+        {
+            if( slot.m_index >= m_made.size() )
+                m_made.resize( slot.m_index + 1 );
+
+            Made& m = m_made[ slot.m_index ];
+            if( m.generation != slot.m_generation ) {
+                PyObject* made = make();
+                ENSURE_OK( made );
+                m.object = Object{ made };          // letting go of what the number's previous holder left, if anything
+                m.generation = slot.m_generation;
             }
+            return m.object;
+        }
 
-        };
+        size_t size() const { return m_made.size(); }
+
+        ~InterpreterObjects() { epoch()++; }
+    };
+
+    /*
+     A str that is interned once and then reused, for names used over and over (attributes, dict keys):
+
+            d[ "count"_py ] = n;                    // no str is created; the dict compares the key by pointer
+            ob.getAttr( "x"_py );
+
+     Interning is lazy (first use), so an Interned can be a static created before Py_Initialize.
+     Each interpreter has its own str for it (see InterpreterObjects): a new Py_Initialize, or another
+     subinterpreter, interns again rather than reusing a str of a runtime that has ended.
+     */
+    class Interned
+    {
+    protected:
+        std::string                 m_text;
+        InterpreterObjects::Slot    m_slot;
 
     public:
-        using value_type      = Object;
-        using reference       = value_type&;
-        using const_reference = const reference;
-        using difference_type = ptrdiff_t;
-        using size_type       = Py_ssize_t;
-        using iterator        = iterator_base<false>;
-        using const_iterator  = iterator_base<true>;
+        explicit Interned( std::string text ) : m_text{ std::move(text) } { }
 
-        Py_ssize_t              length()        const { return PyObject_Length(p); }  // was PySequence_Length
-        Py_ssize_t              size()          const { return PyObject_Length(p); }  // was PySequence_Length
-        Py_ssize_t              max_size()      const { return std::numeric_limits<Py_ssize_t>::max(); }
-        bool                    empty()         const { return length()==0; }
+        const std::string& text() const { return m_text; }
 
-        void        swap( Object& o )                 { Object tmp = o;  o = *this;  set_ptr(tmp.p); }
-        friend void swap( Object& a, Object& b )      { a.swap(b); }
+        const Object& name() const { return name( InterpreterObjects::current() ); }
 
-        iterator                begin()         const { return iterator{ *this, 0        }; }
-        iterator                end()           const { return iterator{ *this, length() }; }
+        // ...from the current interpreter's table, for a caller that already has it
+        const Object& name( InterpreterObjects& here ) const {
+            return here.get( m_slot, [this] { return PyUnicode_InternFromString( m_text.c_str() ); } );
+        }
 
-        //const const_iterator    cbegin()        const { return const_iterator{ *this, 0        }; }
-        //const const_iterator    cend()          const { return const_iterator{ *this, length() }; }
+        operator const Object& () const { return name(); }
+    };
 
-    }; // End of class Object
+#if __cplusplus >= 202002L
+    // a string literal as a template argument, for "name"_py
+    template< size_t N >
+    struct FixedString
+    {
+        char text[N];
+        constexpr FixedString( const char (&s)[N] ) { for( size_t i=0; i < N; i++ ) text[i] = s[i]; }
+    };
+
+    /*
+     "name"_py gives the Interned for that literal: one per distinct literal in the program,
+     made the first time it is used (so with no lookup at all after that).
+     */
+    template< FixedString S >
+    inline const Interned& operator""_py()
+    {
+        static const Interned interned{ std::string{ S.text, sizeof(S.text) - 1 } };
+        return interned;
+    }
+#else
+    /*
+     "name"_py gives the process-wide Interned for that literal, looked up by the literal's address.
+     (Before C++20 a literal's characters can't be handed to a template, so the lookup happens at runtime;
+     it is a pointer hash, against building and hashing a new str.)
+     */
+    inline const Interned& operator""_py( const char* text, size_t len )
+    {
+        static std::mutex mutex;
+        static std::unordered_map< const char*, std::unique_ptr<Interned> > table;
+
+        std::lock_guard<std::mutex> lock{ mutex };
+        std::unique_ptr<Interned>& slot = table[text];
+        if( ! slot )
+            slot.reset( new Interned{ std::string{ text, len } } );
+        return *slot;
+    }
+#endif
+
+    /*
+     An attribute or method name: interned once, then reused by Object::getAttr/setAttr/hasAttr/delAttr and call_method:
+
+            static AttrHandle on_tick{ "on_tick" };
+            loop.call_method( on_tick, dt );        // loop.on_tick(dt): no str made, no bound method (VectorcallMethod)
+
+     What the name resolves to is not cached: CPython's own method lookup already is, per interpreter.
+     */
+    class AttrHandle : public Interned
+    {
+    public:
+        explicit AttrHandle( std::string text ) : Interned{ std::move(text) } { }
+    };
+
+    inline bool   Object::hasAttr( const Interned& h ) const { return PyObject_HasAttr( p, h.name().p ) ? true : false; }
+    inline Object Object::getAttr( const Interned& h ) const { return PyObject_GetAttr( p, h.name().p ); }
+
+    inline void Object::setAttr( const Interned& h, const Object& value ) {
+        ENSURE_OK( PyObject_SetAttr( p, h.name().p, *value ) );
+    }
+
+    inline void Object::delAttr( const Interned& h ) {
+        ENSURE_OK( PyObject_SetAttr( p, h.name().p, nullptr ) );
+    }
+
+
+#pragma mark  I T E R A T O R S
+
+    /*
+     Object is layout-identical to a bare PyObject* (see the static_asserts below Object),
+     so a list/tuple's item array (PyObject**) can be viewed in place as an array of Objects.
+     Hence the random-access iterator for sequences is simply 'const Object*'.
+     */
+    static_assert( std::is_standard_layout<Object>::value, "Object must be standard-layout to view PyObject* arrays in place" );
+
+    inline const Object* as_objects( PyObject** items ) {
+        return reinterpret_cast<const Object*>( items );
+    }
+
+    // - - - - - - -
+
+    /*
+     Random-access range over the items of a list or tuple.
+     Anything else that is iterable gets copied into a list first (PySequence_Fast), which the range then owns.
+     */
+    class SequenceRange
+    {
+    private:
+        Object m_fast;
+
+    public:
+        using iterator = const Object*;
+
+        explicit SequenceRange( const Object& ob )
+            : m_fast{ PyList_CheckExact(ob.p) || PyTuple_CheckExact(ob.p) ? charge(ob.p)
+                                                                          : PySequence_Fast( ob.p, "as_sequence: object is not iterable" ) }
+        {
+            ENSURE_OK( m_fast.p );
+        }
+
+        Py_ssize_t      size()                          const { return PySequence_Fast_GET_SIZE(m_fast.p); }
+        bool            empty()                         const { return size() == 0; }
+
+        iterator        begin()                         const { return as_objects( PySequence_Fast_ITEMS(m_fast.p) ); }
+        iterator        end()                           const { return begin() + size(); }
+
+        const Object&   operator[] ( Py_ssize_t i )     const { return begin()[i]; }
+    };
+
+    // - - - - - - -
+
+    /*
+     Forward iterator over an exact dict using PyDict_Next.
+     Keys and values are borrowed from the dict; the position is PyDict_Next's cursor, -1 once exhausted.
+     */
+    template< DictPart part >
+    class DictIterator
+    {
+    private:
+        PyObject*   m_dict;
+        Py_ssize_t  m_pos;
+        Borrowed    m_key{ nullptr };
+        Borrowed    m_value{ nullptr };
+
+        void next() {
+            PyObject *k, *v;
+            if( PyDict_Next( m_dict, &m_pos, &k, &v ) ) {
+                m_key   = Borrowed{k};
+                m_value = Borrowed{v};
+            }
+            else
+                m_pos = -1;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = typename std::conditional< part==DictPart::Items, std::pair<Object,Object>, Object >::type;
+        using reference         = typename std::conditional< part==DictPart::Items, std::pair<const Object&, const Object&>, const Object& >::type;
+        using pointer           = void;
+        using difference_type   = ptrdiff_t;
+
+        // (pass pos = -1 for the end iterator)
+        DictIterator( PyObject* dict, Py_ssize_t pos ) : m_dict{dict}, m_pos{pos} {
+            if( m_pos >= 0 ) next();
+        }
+
+        DictIterator& operator++()      { next(); return *this; }
+        DictIterator  operator++( int ) { DictIterator i{*this}; next(); return i; }
+
+        friend bool operator == ( const DictIterator& lhs, const DictIterator& rhs ) { return lhs.m_pos == rhs.m_pos; }
+        friend bool operator != ( const DictIterator& lhs, const DictIterator& rhs ) { return lhs.m_pos != rhs.m_pos; }
+
+        template< DictPart P = part, subfail_unless_t<P==DictPart::Keys>   = 0 >  const Object& operator*() const { return m_key; }
+        template< DictPart P = part, subfail_unless_t<P==DictPart::Values> = 0 >  const Object& operator*() const { return m_value; }
+        template< DictPart P = part, subfail_unless_t<P==DictPart::Items>  = 0 >  reference     operator*() const { return reference{ m_key, m_value }; }
+    };
+
+    template< DictPart part >
+    class DictRange
+    {
+    private:
+        Object m_dict;
+
+    public:
+        using iterator = DictIterator<part>;
+
+        explicit DictRange( const Object& dict ) : m_dict{dict} {
+            if( ! PyDict_Check(m_dict.p) )
+                THROW( "iter_keys/iter_values/iter_items: object is not a dict" );
+        }
+
+        iterator begin() const { return iterator{ m_dict.p,  0 }; }
+        iterator end()   const { return iterator{ m_dict.p, -1 }; }
+    };
+
+    // - - - - - - -
+
+    /*
+     What Object::begin()/end() hand out: dispatches once on the container's exact type (see Object's C O N T A I N E R notes).
+     For a generic iterable we hold the Python iterator and the current item; the end iterator holds neither.
+     Which kind it is is only known at run time, so it is tagged for the weakest: input (single-pass).
+     */
+    class ObjectIterator
+    {
+    private:
+        enum class Kind : char { Sequence, Dict, Generic };
+
+        Kind                        m_kind;
+        const Object*               m_item{ nullptr };          // Sequence
+        DictIterator<DictPart::Keys> m_dict{ nullptr, -1 };     // Dict
+        Object                      m_iter{ (PyObject*)nullptr }; // Generic
+        Object                      m_current{ (PyObject*)nullptr };
+
+        void next_generic() {
+            m_current = PyIter_Next( m_iter.p ); // PyIter_Next returns CHARGED ptr, or nullptr when exhausted (or on error)
+            if( m_current.isNull() ) {
+                m_iter = (PyObject*)nullptr;
+                throw_if_pyerr( TRACE, "error while iterating" );
+            }
+        }
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = Object;
+        using reference         = const Object&;
+        using pointer           = const Object*;
+        using difference_type   = ptrdiff_t;
+
+        explicit ObjectIterator( const Object*                item ) : m_kind{ Kind::Sequence }, m_item{ item } { }
+        explicit ObjectIterator( DictIterator<DictPart::Keys> it   ) : m_kind{ Kind::Dict }, m_dict{ it } { }
+        explicit ObjectIterator( Object                       iter ) : m_kind{ Kind::Generic }, m_iter{ std::move(iter) } {
+            if( ! m_iter.isNull() ) next_generic();
+        }
+
+        ObjectIterator& operator++() {
+            switch( m_kind ) {
+                case Kind::Sequence:  ++m_item;         break;
+                case Kind::Dict:      ++m_dict;         break;
+                case Kind::Generic:   next_generic();   break;
+            }
+            return *this;
+        }
+        ObjectIterator operator++( int ) { ObjectIterator i{*this}; ++*this; return i; }
+
+        reference operator*() const {
+            return m_kind == Kind::Sequence ? *m_item
+                 : m_kind == Kind::Dict     ? *m_dict
+                 :                            m_current;
+        }
+        pointer operator->() const { return &**this; }
+
+        // compares positions only, never the items themselves
+        friend bool operator == ( const ObjectIterator& lhs, const ObjectIterator& rhs ) {
+            return lhs.m_kind == Kind::Sequence ? lhs.m_item   == rhs.m_item
+                 : lhs.m_kind == Kind::Dict     ? lhs.m_dict   == rhs.m_dict
+                 :                                lhs.m_iter.p == rhs.m_iter.p;
+        }
+        friend bool operator != ( const ObjectIterator& lhs, const ObjectIterator& rhs ) { return !(lhs == rhs); }
+    };
+
+    inline Object::iterator Object::begin() const {
+        if( PyList_CheckExact(p) || PyTuple_CheckExact(p) )
+            return iterator{ as_objects( PySequence_Fast_ITEMS(p) ) };
+        if( PyDict_CheckExact(p) )
+            return iterator{ DictIterator<DictPart::Keys>{ p, 0 } };
+
+        Object it{ PyObject_GetIter(p) }; // CHARGED
+        ENSURE_OK( it.p );
+        return iterator{ std::move(it) };
+    }
+
+    inline Object::iterator Object::end() const {
+        if( PyList_CheckExact(p) || PyTuple_CheckExact(p) )
+            return iterator{ as_objects( PySequence_Fast_ITEMS(p) ) + PySequence_Fast_GET_SIZE(p) };
+        if( PyDict_CheckExact(p) )
+            return iterator{ DictIterator<DictPart::Keys>{ p, -1 } };
+
+        return iterator{ Object{ (PyObject*)nullptr } };
+    }
+
+    inline Object::const_iterator Object::cbegin() const { return begin(); }
+    inline Object::const_iterator Object::cend()   const { return end(); }
+
+    inline SequenceRange                 Object::as_sequence() const { return SequenceRange{ *this }; }
+    inline DictRange<DictPart::Keys>     Object::iter_keys()   const { return DictRange<DictPart::Keys>  { *this }; }
+    inline DictRange<DictPart::Values>   Object::iter_values() const { return DictRange<DictPart::Values>{ *this }; }
+    inline DictRange<DictPart::Items>    Object::iter_items()  const { return DictRange<DictPart::Items> { *this }; }
 
+    // (args passed to a METH_VARARGS handler are never null, but kwds are null whenever no keywords were given)
     static inline Object to_tuple(PyObject* pyob) {
         return Object{ pyob ? charge(pyob) : PyTuple_New(0) };
     }
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+/*
+ Tiny timing helpers shared by the benchmarks.
+
+ Benchmarks are built with PICXX_DEBUG=0 (see 'make bench'), otherwise the COUT tracing
+ inside πcxx would swamp whatever we are trying to measure.
+ */
+
+namespace Bench
+{
+    using clock = std::chrono::steady_clock;
+
+    // run f() n times, return nanoseconds per iteration
+    template <typename F>
+    double ns_per_op( long n, F&& f )
+    {
+        auto t0 = clock::now();
+        for( long i=0; i < n; i++ )
+            f();
+        auto t1 = clock::now();
+
+        return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+    }
+
+    inline void report( const std::string& what, double ns )
+    {
+        std::cout << "    " << std::left << std::setw(48) << what
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(1) << ns << " ns/op" << std::endl;
+    }
+
+    inline void report_bytes( const std::string& what, size_t bytes )
+    {
+        std::cout << "    " << std::left << std::setw(48) << what
+                  << std::right << std::setw(10) << bytes / (1024*1024) << " MiB" << std::endl;
+    }
+
+    inline void heading( const std::string& what )
+    {
+        std::cout << "\n- - - " << what << " - - -" << std::endl;
+    }
+}
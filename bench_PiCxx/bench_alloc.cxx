@@ -0,0 +1,92 @@
+/*
+  Benchmarks for allocation-heavy arithmetic: every a + b makes a new extension object,
+  with and without a per-type free list (OldStyle), and for comparison a NewStyle inline object,
+  whose memory is all pymalloc's.
+ */
+
+#include "ExtModule.hxx"
+#include "bench.hxx"
+
+using namespace Py;
+
+
+template< size_t cap >
+class bench_vec_old : public OldStyle< bench_vec_old<cap> >
+{
+public:
+    static constexpr size_t free_list_cap = cap;
+
+    double x, y, z;
+
+    bench_vec_old( double x_, double y_, double z_ ) : x{x_}, y{y_}, z{z_} { }
+
+    static void setup()
+    {
+        bench_vec_old::typeobject().setName( cap ? "vec_old_free_list" : "vec_old" );
+        bench_vec_old::typeobject().supportNumberType();
+    }
+
+    Object number_add( const Object other ) override
+    {
+        auto o = static_cast<bench_vec_old*>( cxxbase_for( other.p ) );
+        return Object{ new bench_vec_old{ x + o->x, y + o->y, z + o->z } };
+    }
+};
+
+class bench_vec_new : public NewStyle< bench_vec_new >
+{
+public:
+    static constexpr bool inline_storage = true;
+
+    double x{0}, y{0}, z{0};
+
+    bench_vec_new( Bridge* self, const Object& args, const Object& kwds )
+        : NewStyle< bench_vec_new >::NewStyle( self, args, kwds )
+    { }
+
+    static void setup()
+    {
+        bench_vec_new::typeobject().setName( "vec_new" );
+        bench_vec_new::typeobject().supportNumberType();
+    }
+
+    Object number_add( const Object other ) override
+    {
+        auto o = static_cast<bench_vec_new*>( cxxbase_for( other.p ) );
+        Object sum{ bench_vec_new::type().call() };
+        auto s = static_cast<bench_vec_new*>( cxxbase_for( sum.p ) );
+        s->x = x + o->x;  s->y = y + o->y;  s->z = z + o->z;
+        return sum;
+    }
+};
+
+
+void bench_alloc()
+{
+    Bench::heading( "a + b + a, each + a new extension object" );
+
+    bench_vec_old<0>::one_time_setup();
+    bench_vec_old<256>::one_time_setup();
+    bench_vec_new::one_time_setup();
+
+    Object globals{ PyDict_New() };
+    PyDict_SetItemString( globals.p, "__builtins__", PyEval_GetBuiltins() );
+
+    const long N = 1000*1000;
+
+    auto run = [&]( const Object& a, const Object& b ) {
+        globals["a"] = a;
+        globals["b"] = b;
+        double ns = Bench::ns_per_op( 1, [&]{ Object r{ PyRun_String( "for _ in range(1000000): c = a + b + a\n", Py_file_input, globals.p, globals.p ) }; } ) / N;
+        throw_if_pyerr(TRACE);
+        return ns;
+    };
+
+    Bench::report( "OldStyle",                      run( Object{ new bench_vec_old<0>{ 1, 2, 3 } },   Object{ new bench_vec_old<0>{ 4, 5, 6 } } ) );
+    Bench::report( "OldStyle, free list",           run( Object{ new bench_vec_old<256>{ 1, 2, 3 } }, Object{ new bench_vec_old<256>{ 4, 5, 6 } } ) );
+    Bench::report( "NewStyle inline",               run( bench_vec_new::type().call(),      bench_vec_new::type().call() ) );
+
+    const FreeList::Stats& s = bench_vec_old<256>::instance_free_list().stats();
+    std::cout << "    OldStyle free list: " << s.allocations << " allocations, " << s.reused << " reused, "
+              << s.released << " released, " << s.kept << " kept" << std::endl;
+}
@@ -0,0 +1,53 @@
+/*
+  Benchmarks for calling Python from C++: args-tuple calls versus vectorcall.
+ */
+
+#include "Objects.hxx"
+#include "bench.hxx"
+
+using namespace Py;
+
+
+static const char* bench_call_source =
+    "def f(a, b, c=0):\n"
+    "    return a\n"
+    "class K:\n"
+    "    def m(self, a, b):\n"
+    "        return a\n"
+    "k = K()\n";
+
+void bench_call()
+{
+    Bench::heading( "calling a Python function / method, 2 args" );
+
+    Object globals{ PyDict_New() };
+    PyDict_SetItemString( globals.p, "__builtins__", PyEval_GetBuiltins() );
+    Object ran{ PyRun_String( bench_call_source, Py_file_input, globals.p, globals.p ) };
+    throw_if_pyerr(TRACE);
+
+    Object f{ globals["f"] };
+    Object k{ globals["k"] };
+    Object m_name{ "m" };
+    Object a{ 1 }, b{ 2 };
+
+    const long N = 2*1000*1000;
+
+    Bench::report( "f( Object{'T', a, b} )",
+                   Bench::ns_per_op( N, [&]{ Object r = f( Object('T', a, b) ); } ) );
+    Bench::report( "f.call( a, b )",
+                   Bench::ns_per_op( N, [&]{ Object r = f.call( a, b ); } ) );
+
+    Bench::report( "f( args, kwds )           c=3",
+                   Bench::ns_per_op( N, [&]{ Object r = f( Object('T', a, b), Object('D', "c", 3) ); } ) );
+    Bench::report( "f.call( a, b, kw(\"c\",3) )",
+                   Bench::ns_per_op( N, [&]{ Object r = f.call( a, b, kw("c", 3) ); } ) );
+
+    Bench::report( "k.callMemberFunction( \"m\", args )",
+                   Bench::ns_per_op( N, [&]{ Object r = k.callMemberFunction( "m", Object('T', a, b) ); } ) );
+    Bench::report( "k.call_method( m_name, a, b )",
+                   Bench::ns_per_op( N, [&]{ Object r = k.call_method( m_name, a, b ); } ) );
+
+    static AttrHandle m_handle{ "m" };
+    Bench::report( "k.call_method( m_handle, a, b )   interned",
+                   Bench::ns_per_op( N, [&]{ Object r = k.call_method( m_handle, a, b ); } ) );
+}
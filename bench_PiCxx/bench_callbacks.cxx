@@ -0,0 +1,126 @@
+/*
+  Benchmarks for events from C++ threads into a Python callable: each producer taking the GIL for each event,
+  against a CallbackQueue delivering them in batches (by its own thread, or on the main thread by a pending call),
+  a call per event or a list per batch.
+ */
+
+#include "ExtModule.hxx"
+#include "bench.hxx"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Py;
+
+
+class bench_feed : public NewStyle< bench_feed >
+{
+public:
+    enum Mode { gil_per_event, queue_thread, queue_thread_list, queue_pending_call };
+
+private:
+    std::unique_ptr< CallbackQueue<long long> > m_queue;
+    std::vector< std::thread >                  m_producers;
+    Object                                      m_callback;
+    long long                                   m_events{ 0 };
+
+public:
+    bench_feed( Bridge* self, const Object& args, const Object& kwds )
+        : NewStyle< bench_feed >::NewStyle( self, args, kwds )
+    { }
+
+    static void setup()
+    {
+        typeobject().setName( "bench_feed" );
+        register_method< & bench_feed::start >( "start" );
+        register_method< & bench_feed::wait  >( "wait", nogil );
+    }
+
+    // 'producers' threads between them push 'events' events, and we return at once
+    void start( Object callback, int mode, int events, int producers )
+    {
+        m_callback = callback;
+        m_events = events;
+        m_queue.reset();
+        if( mode != gil_per_event )
+            m_queue.reset( new CallbackQueue<long long>{ callback,
+                                                         mode == queue_pending_call ? CallbackWake::pending_call : CallbackWake::thread,
+                                                         mode == queue_thread_list ? CallbackDelivery::batch : CallbackDelivery::each } );
+
+        long long each = events / producers;
+        for( int t=0; t < producers; t++ )
+            m_producers.emplace_back( [this, mode, each] {
+                for( long long i=0; i < each; i++ ) {
+                    if( mode != gil_per_event ) {
+                        m_queue->push( i );
+                        continue;
+                    }
+                    GilAcquire locked;
+                    PyObject* arg = PyLong_FromLongLong( i );
+                    PyObject* result = PyObject_Vectorcall( m_callback.p, &arg, 1, nullptr );
+                    Py_XDECREF( result );
+                    Py_DECREF( arg );
+                }
+            } );
+    }
+
+    // until every event has been delivered
+    void wait()
+    {
+        for( auto& p : m_producers )
+            p.join();
+        m_producers.clear();
+        if( m_queue )
+            while( m_queue->delivered() < static_cast<size_t>( m_events ) )
+                std::this_thread::yield();
+    }
+};
+
+
+void bench_callbacks()
+{
+    Bench::heading( "events from C++ threads into a Python callable" );
+
+    bench_feed::one_time_setup();
+
+    Object globals{ PyDict_New() };
+    PyDict_SetItemString( globals.p, "__builtins__", PyEval_GetBuiltins() );
+    globals[ "T" ] = bench_feed::type();
+
+    Object setup{ PyRun_String(
+        "o = T()\n"
+        "n = 0\n"
+        "def on_event( x ):\n"
+        "    global n\n"
+        "    n += 1\n"
+        "def on_batch( xs ):\n"
+        "    global n\n"
+        "    n += len( xs )\n"
+        "def run( callback, mode, events, producers, spin ):\n"
+        "    global n\n"
+        "    n = 0\n"
+        "    o.start( callback, mode, events, producers )\n"
+        "    while spin and n < events: pass\n"            // a pending call needs the main thread running Python code
+        "    o.wait()\n", Py_file_input, globals.p, globals.p ) };
+    throw_if_pyerr(TRACE);
+
+    // wall time per event, from the first push to the last delivery
+    auto run = [&]( const char* callback, bench_feed::Mode mode, int producers, long events ) {
+        std::string code = "run( " + std::string{callback} + ", " + std::to_string(mode) + ", " + std::to_string(events) + ", "
+                         + std::to_string(producers) + ", " + ( mode == bench_feed::queue_pending_call ? "True" : "False" ) + " )\n";
+        double ns = Bench::ns_per_op( 1, [&]{ Object r{ PyRun_String( code.c_str(), Py_file_input, globals.p, globals.p ) }; } ) / events;
+        throw_if_pyerr(TRACE);
+        return ns;
+    };
+
+    std::cout << "    (" << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+
+    for( int producers : { 1, 4 } ) {
+        std::string p = std::to_string(producers) + " producer" + ( producers > 1 ? "s" : "" );
+        Bench::report( "GIL taken per event, "          + p,   run( "on_event", bench_feed::gil_per_event,      producers, 200000 ) );
+        Bench::report( "queue, its thread, per event, " + p,   run( "on_event", bench_feed::queue_thread,       producers, 200000 ) );
+        Bench::report( "queue, its thread, a list, "    + p,   run( "on_batch", bench_feed::queue_thread_list,  producers, 200000 ) );
+        Bench::report( "queue, pending call, per event, " + p, run( "on_event", bench_feed::queue_pending_call, producers, 200000 ) );
+    }
+}
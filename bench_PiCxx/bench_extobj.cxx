@@ -0,0 +1,272 @@
+/*
+  Benchmarks for calling C++ extension-object methods from Python: OldStyle versus NewStyle.
+ */
+
+#include "ExtModule.hxx"
+#include "bench.hxx"
+
+using namespace Py;
+
+
+class bench_new_style : public NewStyle< bench_new_style >
+{
+public:
+    bench_new_style( Bridge* self, const Object& args, const Object& kwds )
+        : NewStyle< bench_new_style >::NewStyle( self, args, kwds )
+    { }
+
+    static void setup()
+    {
+        typeobject().setName( "bench_new_style" );
+        register_method< & bench_new_style::f >( "f" );
+    }
+
+    Object f() { return None(); }
+};
+
+// the same value-like class, with its C++ object on the heap / inside the Python object
+template< bool in_place >
+class bench_point : public NewStyle< bench_point<in_place> >
+{
+public:
+    static constexpr bool inline_storage = in_place;
+
+    double x{ 1 }, y{ 2 };
+
+    bench_point( Bridge* self, const Object& args, const Object& kwds )
+        : NewStyle< bench_point >::NewStyle( self, args, kwds )
+    { }
+
+    static void setup()
+    {
+        bench_point::typeobject().setName( in_place ? "bench_point_inline" : "bench_point_heap" );
+        bench_point::template register_method< & bench_point::norm2 >( "norm2" );
+        bench_point::template register_member< & bench_point::x >( "x" );
+        bench_point::template register_member< & bench_point::y >( "y" );
+        bench_point::template register_property< & bench_point::get_x >( "px" );
+    }
+
+    double norm2() const { return x*x + y*y; }
+    double get_x() const { return x; }
+};
+
+// p.x the way it had to be done before register_member: a getattro override comparing names
+class bench_point_getattro : public NewStyle< bench_point_getattro >
+{
+public:
+    double x{ 1 }, y{ 2 };
+
+    bench_point_getattro( Bridge* self, const Object& args, const Object& kwds )
+        : NewStyle< bench_point_getattro >::NewStyle( self, args, kwds )
+    { }
+
+    static void setup()
+    {
+        typeobject().setName( "bench_point_getattro" );
+    }
+
+    Object getattro( const Object name ) override
+    {
+        std::string s{ name.as_string() };
+        if( s == "x" )  return Object{ x };
+        if( s == "y" )  return Object{ y };
+        return NewStyle< bench_point_getattro >::getattro( name );
+    }
+};
+
+class bench_old_style : public OldStyle< bench_old_style >
+{
+public:
+    static void setup()
+    {
+        typeobject().setName( "bench_old_style" );
+        register_method( "f", & bench_old_style::f );
+    }
+
+    Object f() { return None(); }
+};
+
+// What every OldStyle attribute access used to do: build a fresh function object for the method
+class bench_old_style_uncached : public OldStyle< bench_old_style_uncached >
+{
+public:
+    static void setup()
+    {
+        typeobject().setName( "bench_old_style_uncached" );
+        register_method( "f", & bench_old_style_uncached::f );
+    }
+
+    Object f() { return None(); }
+
+protected:
+    Object getattr_methods( const std::string& name ) override
+    {
+        auto i = method_map().find(name);
+        if( i == method_map().end() )
+            THROW( std::string{"Attribute error:"} + name );
+        return i->second->ConstructPyFunc(this);
+    }
+};
+
+class bench_module : public ExtModule< bench_module >
+{
+public:
+    bench_module() : ExtModule< bench_module >::ExtModule{ "bench_extobj", "" }
+    {
+        moduleDictionary()[ "bench_new_style" ] = bench_new_style::type();
+        moduleDictionary()[ "bench_point_heap" ] = bench_point<false>::type();
+        moduleDictionary()[ "bench_point_inline" ] = bench_point<true>::type();
+        moduleDictionary()[ "bench_point_getattro" ] = bench_point_getattro::type();
+    }
+
+    static void register_methods_and_classes()
+    {
+        register_method( "old_style",          & bench_module::make_old_style );
+        register_method( "old_style_uncached", & bench_module::make_old_style_uncached );
+        register_method( "add_classic",        & bench_module::add_classic );
+        register_method< & bench_module::add_typed >( "add_typed" );
+        register_method( "opts_classic",       & bench_module::opts_classic );
+        register_method< & bench_module::opts_typed >( "opts_typed", { arg("a"), arg("b") = 2, arg("c") = 3, arg("d") = 4, kw_only,
+                                                                       arg("e") = 5, arg("f") = 6, arg("g") = 7, arg("h") = 8 } );
+        register_method( "transform_classic",  & bench_module::transform_classic );
+        register_method< & bench_module::transform_point >( "transform" );
+        register_method< & bench_module::transform_array >( "transform" );
+        register_method< & bench_module::transform_list  >( "transform" );
+
+        bench_old_style::one_time_setup();
+        bench_old_style_uncached::one_time_setup();
+        bench_new_style::one_time_setup();
+        bench_point<false>::one_time_setup();
+        bench_point<true>::one_time_setup();
+        bench_point_getattro::one_time_setup();
+    }
+
+private:
+    Object make_old_style()          { return Object{ new bench_old_style }; }
+    Object make_old_style_uncached() { return Object{ new bench_old_style_uncached }; }
+
+    // the same function, unpacking an args tuple by hand / with a typed signature
+    Object add_classic( const Object& args ) {
+        if( args.size() != 2 )
+            THROW( "add_classic: expected 2 arguments" );
+        return Object{ static_cast<double>( args[0] ) + static_cast<double>( args[1] ) };
+    }
+    double add_typed( double a, double b ) { return a + b; }
+
+    // eight parameters, seven of them optional keywords: looked up one by one in the kwargs dict / bound from a spec
+    Object opts_classic( const Object& args, const Object& kwds ) {
+        static const char* names[] = { "b", "c", "d", "e", "f", "g", "h" };
+        Object k{ kwds };
+        long sum = static_cast<long>( args[0] );
+        long dflt = 2;
+        for( const char* name : names ) {
+            Object v{ k[name] };                    // (a missing key reads None)
+            sum += v.isNone() ? dflt : static_cast<long>(v);
+            dflt++;
+        }
+        return Object{ sum };
+    }
+    long opts_typed( long a, long b, long c, long d, long e, long f, long g, long h ) { return a+b+c+d+e+f+g+h; }
+
+    // point / buffer / list, told apart by hand in one varargs method / registered as three overloads
+    Object transform_classic( const Object& args ) {
+        if( args.size() == 2 )
+            return Object{ static_cast<double>( args[0] ) + static_cast<double>( args[1] ) };
+        Object xs{ args[0] };
+        if( PyObject_CheckBuffer( xs.p ) ) {
+            Py_buffer view;
+            if( PyObject_GetBuffer( xs.p, &view, PyBUF_C_CONTIGUOUS ) < 0 )
+                throw_if_pyerr(TRACE);
+            double sum = 0;
+            for( size_t i=0; i < view.len / sizeof(double); i++ )
+                sum += static_cast<const double*>(view.buf)[i];
+            PyBuffer_Release( &view );
+            return Object{ sum };
+        }
+        if( PyList_Check( xs.p ) ) {
+            double sum = 0;
+            for( Py_ssize_t i=0; i < PyList_GET_SIZE( xs.p ); i++ )
+                sum += static_cast<double>( Borrowed{ PyList_GET_ITEM( xs.p, i ) }.object() );
+            return Object{ sum };
+        }
+        THROW( "transform_classic: expected a point, an array or a list" );
+    }
+    double transform_point( double x, double y )                    { return x + y; }
+    double transform_array( std::span<const double> xs )            { double sum = 0;  for( double x : xs ) sum += x;  return sum; }
+    double transform_list( const std::vector<double>& xs )          { double sum = 0;  for( double x : xs ) sum += x;  return sum; }
+};
+
+
+void bench_extobj()
+{
+    Bench::heading( "Python calling o.f() on an extension object" );
+
+    Object globals{ PyDict_New() };
+    PyDict_SetItemString( globals.p, "__builtins__", PyEval_GetBuiltins() );
+    globals[ "m" ] = bench_module::reset();
+
+    Object setup{ PyRun_String(
+        "o_old = m.old_style()\n"
+        "o_uncached = m.old_style_uncached()\n"
+        "o_new = m.bench_new_style()\n", Py_file_input, globals.p, globals.p ) };
+    throw_if_pyerr(TRACE);
+
+    const long N = 1000*1000;
+
+    auto run = [&]( const char* loop ) {
+        double ns = Bench::ns_per_op( 1, [&]{ Object r{ PyRun_String( loop, Py_file_input, globals.p, globals.p ) }; } ) / N;
+        throw_if_pyerr(TRACE);
+        return ns;
+    };
+
+    double ns_uncached = run( "for _ in range(1000000): o_uncached.f()\n" );
+    double ns_old      = run( "for _ in range(1000000): o_old.f()\n" );
+    double ns_new      = run( "for _ in range(1000000): o_new.f()\n" );
+
+    Bench::report( "OldStyle, function object built per access", ns_uncached );
+    Bench::report( "OldStyle, cached per instance",              ns_old );
+    Bench::report( "NewStyle, tp_methods",                        ns_new );
+
+    double ns_classic  = run( "for _ in range(1000000): m.add_classic(1.5, 2.5)\n" );
+    double ns_typed    = run( "for _ in range(1000000): m.add_typed(1.5, 2.5)\n" );
+
+    Bench::report( "module add(a, b), Object(args) signature",   ns_classic );
+    Bench::report( "module add(a, b), double(double, double)",   ns_typed );
+
+    double ns_opts_classic = run( "for _ in range(1000000): m.opts_classic(1, c=3, f=6, h=8)\n" );
+    double ns_opts_typed   = run( "for _ in range(1000000): m.opts_typed(1, c=3, f=6, h=8)\n" );
+
+    Bench::report( "8 params / 3 keywords, kwargs dict",         ns_opts_classic );
+    Bench::report( "8 params / 3 keywords, parameter spec",      ns_opts_typed );
+
+    Object more{ PyRun_String( "xs = [1.0, 2.0, 3.0]\n", Py_file_input, globals.p, globals.p ) };
+    throw_if_pyerr(TRACE);
+
+    Bench::report( "transform(xs), isinstance chain in one F1",    run( "for _ in range(1000000): m.transform_classic(xs)\n" ) );
+    Bench::report( "transform(xs), 3 overloads, same types",       run( "for _ in range(1000000): m.transform(xs)\n" ) );
+    Bench::report( "alternating point / xs, per call, classic",    run( "for _ in range(500000): m.transform_classic(1.0, 2.0); m.transform_classic(xs)\n" ) );
+    Bench::report( "alternating point / xs, per call, overloads",  run( "for _ in range(500000): m.transform(1.0, 2.0); m.transform(xs)\n" ) );
+
+    // (calls spread over 100000 live objects, so the C++ objects don't all sit in cache)
+    Object points{ PyRun_String( "P, Q = m.bench_point_heap, m.bench_point_inline\n"
+                                 "ps = [ P() for _ in range(100000) ]\n"
+                                 "qs = [ Q() for _ in range(100000) ]\n", Py_file_input, globals.p, globals.p ) };
+    throw_if_pyerr(TRACE);
+
+    Bench::report( "NewStyle create + destroy, C++ object on heap",  run( "for _ in range(1000000): P()\n" ) );
+    Bench::report( "NewStyle create + destroy, inline_storage",      run( "for _ in range(1000000): Q()\n" ) );
+    Bench::report( "p.norm2() over 100k objects, on heap",            run( "for _ in range(10):\n  for p in ps: p.norm2()\n" ) );
+    Bench::report( "p.norm2() over 100k objects, inline_storage",     run( "for _ in range(10):\n  for q in qs: q.norm2()\n" ) );
+
+    Object attrs{ PyRun_String( "g, p, q = m.bench_point_getattro(), P(), Q()\n", Py_file_input, globals.p, globals.p ) };
+    throw_if_pyerr(TRACE);
+
+    Bench::report( "p.x, getattro override",                      run( "for _ in range(1000000): g.x\n" ) );
+    Bench::report( "p.x, register_member, heap (tp_getset)",      run( "for _ in range(1000000): p.x\n" ) );
+    Bench::report( "p.x, register_member, inline (tp_members)",   run( "for _ in range(1000000): q.x\n" ) );
+    Bench::report( "p.px, register_property",                     run( "for _ in range(1000000): q.px\n" ) );
+
+    std::cout << "    calls/s:  old uncached " << static_cast<long>( 1e9 / ns_uncached )
+              << ",  old cached " << static_cast<long>( 1e9 / ns_old )
+              << ",  new " << static_cast<long>( 1e9 / ns_new ) << std::endl;
+}
@@ -0,0 +1,90 @@
+/*
+  Benchmarks for methods registered nogil: Python threads calling a C++ method at once,
+  with the method holding the GIL throughout and with it released for the body.
+
+  Two kinds of body: CPU work (which only gains with more than one core) and a blocking wait
+  standing in for I/O (which gains even on one core, the other threads getting on meanwhile).
+ */
+
+#include "ExtModule.hxx"
+#include "bench.hxx"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace Py;
+
+
+class bench_gil : public NewStyle< bench_gil >
+{
+public:
+    bench_gil( Bridge* self, const Object& args, const Object& kwds )
+        : NewStyle< bench_gil >::NewStyle( self, args, kwds )
+    { }
+
+    static void setup()
+    {
+        typeobject().setName( "bench_gil" );
+        register_method< & bench_gil::work       >( "work" );
+        register_method< & bench_gil::work_nogil >( "work_nogil", nogil );
+        register_method< & bench_gil::wait       >( "wait" );
+        register_method< & bench_gil::wait_nogil >( "wait_nogil", nogil );
+    }
+
+    static double work( int n )
+    {
+        double s = 0;
+        for( int i=0; i < n; i++ )
+            s += std::sqrt( static_cast<double>(i) );
+        return s;
+    }
+    static double work_nogil( int n ) { return work( n ); }
+
+    static void wait( int us )       { std::this_thread::sleep_for( std::chrono::microseconds( us ) ); }
+    static void wait_nogil( int us ) { wait( us ); }
+};
+
+
+void bench_gil()
+{
+    Bench::heading( "Python threads calling one C++ method, holding the GIL / nogil" );
+
+    bench_gil::one_time_setup();
+
+    Object globals{ PyDict_New() };
+    PyDict_SetItemString( globals.p, "__builtins__", PyEval_GetBuiltins() );
+    globals[ "T" ] = bench_gil::type();
+
+    Object setup{ PyRun_String(
+        "import threading\n"
+        "o = T()\n"
+        "def loop( f, arg, calls ):\n"
+        "    for _ in range(calls): f(arg)\n"
+        "def run( f, arg, threads, calls ):\n"
+        "    ts = [ threading.Thread( target=loop, args=( f, arg, calls // threads ) ) for _ in range(threads) ]\n"
+        "    for t in ts: t.start()\n"
+        "    for t in ts: t.join()\n", Py_file_input, globals.p, globals.p ) };
+    throw_if_pyerr(TRACE);
+
+    // wall time per call, over all the threads
+    auto run = [&]( const char* method, int arg, int threads, long calls ) {
+        std::string code = "run( o." + std::string{method} + ", " + std::to_string(arg) + ", " + std::to_string(threads) + ", " + std::to_string(calls) + " )\n";
+        double ns = Bench::ns_per_op( 1, [&]{ Object r{ PyRun_String( code.c_str(), Py_file_input, globals.p, globals.p ) }; } ) / calls;
+        throw_if_pyerr(TRACE);
+        return ns;
+    };
+
+    std::cout << "    (" << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+
+    for( int threads : { 1, 2, 4, 8 } ) {
+        std::string t = std::to_string(threads) + " thread" + ( threads > 1 ? "s" : "" );
+        Bench::report( "work(20000), GIL held, " + t,   run( "work",       20000, threads, 8000 ) );
+        Bench::report( "work(20000), nogil, "    + t,   run( "work_nogil", 20000, threads, 8000 ) );
+    }
+    for( int threads : { 1, 2, 4, 8 } ) {
+        std::string t = std::to_string(threads) + " thread" + ( threads > 1 ? "s" : "" );
+        Bench::report( "wait(1 ms), GIL held, " + t,    run( "wait",       1000, threads, 400 ) );
+        Bench::report( "wait(1 ms), nogil, "    + t,    run( "wait_nogil", 1000, threads, 400 ) );
+    }
+}
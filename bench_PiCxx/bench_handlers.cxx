@@ -0,0 +1,82 @@
+/*
+  Benchmarks for the NewStyle per-call handlers: noargs, varargs and keyword methods,
+  against the same methods written by hand straight on the C API.
+
+  Both sides are bound to the same object up front (o.f0 / PyCFunction_New(&def, o)),
+  so each loop calls a builtin method object and all that differs is the handler.
+ */
+
+#include "ExtModule.hxx"
+#include "bench.hxx"
+
+using namespace Py;
+
+
+class bench_handlers : public NewStyle< bench_handlers >
+{
+public:
+    bench_handlers( Bridge* self, const Object& args, const Object& kwds )
+        : NewStyle< bench_handlers >::NewStyle( self, args, kwds )
+    { }
+
+    static void setup()
+    {
+        typeobject().setName( "bench_handlers" );
+        register_method< & bench_handlers::f0 >( "f0" );
+        register_method< & bench_handlers::f1 >( "f1" );
+        register_method< & bench_handlers::f2 >( "f2" );
+    }
+
+    Object f0()                                       { return None(); }
+    Object f1( const Object& )                        { return None(); }
+    Object f2( const Object&, const Object& )         { return None(); }
+};
+
+// the same three, by hand
+static PyObject* c_f0( PyObject*, PyObject* )              { Py_RETURN_NONE; }
+static PyObject* c_f1( PyObject*, PyObject* )              { Py_RETURN_NONE; }
+static PyObject* c_f2( PyObject*, PyObject*, PyObject* )   { Py_RETURN_NONE; }
+
+static PyMethodDef c_methods[] = {
+    { "c_f0", (PyCFunction)c_f0, METH_NOARGS,                nullptr },
+    { "c_f1", (PyCFunction)c_f1, METH_VARARGS,               nullptr },
+    { "c_f2", (PyCFunction)c_f2, METH_VARARGS|METH_KEYWORDS, nullptr },
+};
+
+
+void bench_handlers()
+{
+    Bench::heading( "NewStyle method handlers versus the C API" );
+
+    bench_handlers::one_time_setup();
+
+    Object globals{ PyDict_New() };
+    PyDict_SetItemString( globals.p, "__builtins__", PyEval_GetBuiltins() );
+    globals[ "T" ] = bench_handlers::type();
+
+    Object setup{ PyRun_String(
+        "o = T()\n"
+        "f0, f1, f2 = o.f0, o.f1, o.f2\n", Py_file_input, globals.p, globals.p ) };
+    throw_if_pyerr(TRACE);
+
+    Object o{ globals["o"] };
+    for( auto& def : c_methods )
+        globals[ def.ml_name ] = Object{ PyCFunction_New( &def, o.p ) };
+
+    const long N = 1000*1000;
+
+    auto run = [&]( const char* loop ) {
+        double ns = Bench::ns_per_op( 1, [&]{ Object r{ PyRun_String( loop, Py_file_input, globals.p, globals.p ) }; } ) / N;
+        throw_if_pyerr(TRACE);
+        return ns;
+    };
+
+    double empty = run( "for _ in range(1000000): pass\n" );
+
+    Bench::report( "noargs,   C API",         run( "for _ in range(1000000): c_f0()\n"          ) - empty );
+    Bench::report( "noargs,   NewStyle",      run( "for _ in range(1000000): f0()\n"            ) - empty );
+    Bench::report( "varargs,  C API",         run( "for _ in range(1000000): c_f1(1, 2)\n"      ) - empty );
+    Bench::report( "varargs,  NewStyle",      run( "for _ in range(1000000): f1(1, 2)\n"        ) - empty );
+    Bench::report( "keywords, C API",         run( "for _ in range(1000000): c_f2(1, k=2)\n"    ) - empty );
+    Bench::report( "keywords, NewStyle",      run( "for _ in range(1000000): f2(1, k=2)\n"      ) - empty );
+}
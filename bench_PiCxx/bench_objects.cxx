@@ -0,0 +1,205 @@
+/*
+  Benchmarks for the Object wrapper.
+  Each section prints a before/after style comparison where the "before" can still be expressed.
+ */
+
+#include "Objects.hxx"
+#include "bench.hxx"
+
+#include <vector>
+
+using namespace Py;
+
+
+// The layout Object used to have, when the [] proxy state lived inside every Object
+struct LegacyObjectLayout
+{
+    PyObject*   p;
+    bool        m_resolve_me;
+    PyObject*   m_container;
+    PyObject*   m_key;
+
+    LegacyObjectLayout() : p{ charge(Py_None) }, m_resolve_me{false}, m_container{nullptr}, m_key{nullptr} { }
+    LegacyObjectLayout( const LegacyObjectLayout& o ) : p{ charge(o.p) }, m_resolve_me{false}, m_container{nullptr}, m_key{nullptr} { }
+    ~LegacyObjectLayout() { Py_XDECREF(p); }
+};
+
+
+static void bench_footprint()
+{
+    Bench::heading( "footprint: std::vector of 10M Objects" );
+
+    const size_t N = 10*1000*1000;
+
+    std::cout << "    sizeof(Object) = " << sizeof(Object)
+              << ", legacy layout = " << sizeof(LegacyObjectLayout) << std::endl;
+
+    double ns_legacy = Bench::ns_per_op( 1, [&]{ std::vector<LegacyObjectLayout> v(N); } );
+    double ns_object = Bench::ns_per_op( 1, [&]{ std::vector<Object>             v(N); } );
+
+    Bench::report_bytes( "legacy layout  (heap)", N * sizeof(LegacyObjectLayout) );
+    Bench::report_bytes( "Object         (heap)", N * sizeof(Object) );
+    Bench::report( "legacy layout  fill+destroy, per element", ns_legacy / N );
+    Bench::report( "Object         fill+destroy, per element", ns_object / N );
+}
+
+
+// What 'd[k] = v' used to cost: the proxy eagerly did PyObject_GetItem (raising KeyError for a new key),
+// having first checked PyErr_Occurred, then cleared the error, and finally did PyObject_SetItem
+static void legacy_subscript_assign( const Object& c, const Object& k, const Object& v )
+{
+    throw_if_pyerr(TRACE);
+    PyObject* item = PyObject_GetItem( c.p, k.p );
+    if( item == nullptr ) {
+        PyErr_Clear();
+        item = charge(Py_None);
+    }
+    Object held{ item };
+    PyObject_SetItem( c.p, k.p, v.p );
+}
+
+static void bench_dict_fill()
+{
+    Bench::heading( "dict fill: d[k] = v with 1M new keys" );
+
+    const long N = 1000*1000;
+
+    std::vector<Object> int_keys, str_keys;
+    int_keys.reserve(N);
+    str_keys.reserve(N);
+    for( long i=0; i < N; i++ ) {
+        int_keys.emplace_back( i );
+        str_keys.emplace_back( "key" + std::to_string(i) );
+    }
+    Object v{ 42 };
+
+    for( auto* keys : { &int_keys, &str_keys } )
+    {
+        std::string what = keys == &int_keys ? "int keys" : "str keys";
+        long i;
+
+        Object d0{ 'D' };
+        i = 0;
+        Bench::report( "before (eager GetItem + KeyError), " + what, Bench::ns_per_op( N, [&]{ legacy_subscript_assign( d0, (*keys)[i++], v ); } ) );
+
+        Object d1{ 'D' };
+        i = 0;
+        Bench::report( "after  (ItemProxy),                " + what, Bench::ns_per_op( N, [&]{ d1[ (*keys)[i++] ] = v; } ) );
+    }
+}
+
+
+static void bench_iteration()
+{
+    Bench::heading( "range-for over a 1M-element list / dict" );
+
+    const long N = 1000*1000;
+
+    Object list{ PyList_New(N) };
+    Object dict{ 'D' };
+    for( long i=0; i < N; i++ ) {
+        PyList_SET_ITEM( list.p, i, PyLong_FromLong(i) ); // steals
+        dict[i] = i;
+    }
+
+    long sink = 0;
+
+    // What iterator_base::operator* used to do: box the index, then PyObject_GetItem
+    Bench::report( "before (boxed index + GetItem), list, per item", Bench::ns_per_op( 1, [&]{
+        for( Py_ssize_t i=0; i < N; i++ ) {
+            Object index{ PyLong_FromSsize_t(i) };
+            Object item{ PyObject_GetItem( list.p, index.p ) };
+            sink += (long)(intptr_t)item.p;
+        }
+    } ) / N );
+    Bench::report( "after  (item array in place),   list, per item", Bench::ns_per_op( 1, [&]{
+        for( const Object& item : list )
+            sink += (long)(intptr_t)item.p;
+    } ) / N );
+
+    Bench::report( "before (materialise keys()),    dict, per key ", Bench::ns_per_op( 1, [&]{
+        for( const Object& key : dict.keys() )
+            sink += (long)(intptr_t)key.p;
+    } ) / N );
+    Bench::report( "after  (PyDict_Next),           dict, per key ", Bench::ns_per_op( 1, [&]{
+        for( const Object& key : dict )
+            sink += (long)(intptr_t)key.p;
+    } ) / N );
+
+    if( sink == 42 ) std::cout << "";
+}
+
+
+static void bench_names()
+{
+    Bench::heading( "names: string literal vs interned \"..\"_py" );
+
+    const long N = 2*1000*1000;
+
+    Object d{ 'D', "count", 1 };
+    const Object& cd = d;
+    Object m{ PyImport_ImportModule("sys") };
+
+    Bench::report( "dict read   cd[\"count\"]",     Bench::ns_per_op( N, [&]{ Object v = cd[ "count"   ]; } ) );
+    Bench::report( "dict read   cd[\"count\"_py]",  Bench::ns_per_op( N, [&]{ Object v = cd[ "count"_py ]; } ) );
+    Bench::report( "getAttr(\"maxsize\")",          Bench::ns_per_op( N, [&]{ Object v = m.getAttr( "maxsize"   ); } ) );
+    Bench::report( "getAttr(\"maxsize\"_py)",       Bench::ns_per_op( N, [&]{ Object v = m.getAttr( "maxsize"_py ); } ) );
+}
+
+// What 'std::string(ob)' used to cost: str -> (convert_to) str -> utf-8 bytes -> std::string
+static std::string legacy_to_string( const Object& ob )
+{
+    Object as_unicode{ ob.convert_to(PyUnicode_Type) };
+    Object as_utf8{ PyUnicode_AsUTF8String(as_unicode.p) };
+    return std::string{ PyBytes_AsString(as_utf8.p) };
+}
+
+static void bench_strings()
+{
+    Bench::heading( "reading a short str into C++" );
+
+    const long N = 2*1000*1000;
+
+    Object s{ "some_identifier" };
+    size_t total = 0;
+
+    Bench::report( "before (str -> bytes -> std::string)",  Bench::ns_per_op( N, [&]{ total += legacy_to_string(s).size(); } ) );
+    Bench::report( "after  std::string(ob)",                 Bench::ns_per_op( N, [&]{ total += static_cast<std::string>(s).size(); } ) );
+    Bench::report( "after  ob.as_string_view()",             Bench::ns_per_op( N, [&]{ total += s.as_string_view().size(); } ) );
+
+    if( total == 0 ) std::cout << "";
+}
+
+static void bench_numbers()
+{
+    Bench::heading( "reading an int / float into C++" );
+
+    const long N = 2*1000*1000;
+
+    Object i{ 12345 }, f{ 1.5 };
+    long   li = 0;
+    double df = 0;
+
+    // before: every read went through convert_to (a charged copy for an exact type, else a call of the type object)
+    Object b{ True() };
+    Bench::report( "before  convert_to(int), exact int",        Bench::ns_per_op( N, [&]{ li += PyLong_AsLong( i.convert_to(PyLong_Type).p ); } ) );
+    Bench::report( "after   static_cast<long>(ob)",             Bench::ns_per_op( N, [&]{ li += static_cast<long>(i); } ) );
+    Bench::report( "after   ob.try_as<long>()",                 Bench::ns_per_op( N, [&]{ li += *i.try_as<long>(); } ) );
+    Bench::report( "before  convert_to(int), bool",             Bench::ns_per_op( N, [&]{ li += PyLong_AsLong( b.convert_to(PyLong_Type).p ); } ) );
+    Bench::report( "after   static_cast<long>(bool)",           Bench::ns_per_op( N, [&]{ li += static_cast<long>(b); } ) );
+    Bench::report( "before  convert_to(float), int",            Bench::ns_per_op( N, [&]{ df += PyFloat_AsDouble( i.convert_to(PyFloat_Type).p ); } ) );
+    Bench::report( "after   static_cast<double>(int)",          Bench::ns_per_op( N, [&]{ df += static_cast<double>(i); } ) );
+    Bench::report( "after   static_cast<double>(ob)",           Bench::ns_per_op( N, [&]{ df += static_cast<double>(f); } ) );
+
+    if( li == 0 || df == 0 ) std::cout << "";
+}
+
+void bench_objects()
+{
+    bench_footprint();
+    bench_dict_fill();
+    bench_iteration();
+    bench_names();
+    bench_strings();
+    bench_numbers();
+}
@@ -0,0 +1,67 @@
+/*
+  Benchmarks for offloaded methods: what a round trip through the thread pool and a future costs,
+  and CPU work submitted all at once then gathered, against the same calls made one after another.
+ */
+
+#include "ExtModule.hxx"
+#include "bench.hxx"
+
+using namespace Py;
+
+
+class bench_offload : public NewStyle< bench_offload >
+{
+public:
+    bench_offload( Bridge* self, const Object& args, const Object& kwds )
+        : NewStyle< bench_offload >::NewStyle( self, args, kwds )
+    { }
+
+    static void setup()
+    {
+        typeobject().setName( "bench_offload" );
+        register_method< & bench_offload::work     >( "work" );
+        register_method< & bench_offload::work_off >( "work_off", offload );
+    }
+
+    // (an xorshift chain: no libm call that could change how the loop compiles once inlined into the pool's task)
+    static long long work( int n )
+    {
+        unsigned long long x = 88172645463325252ULL;
+        for( int i=0; i < n; i++ ) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+        }
+        return static_cast<long long>( x >> 1 );
+    }
+    static long long work_off( int n ) { return work( n ); }
+};
+
+
+void bench_offload()
+{
+    Bench::heading( "offloaded methods: the thread pool and its futures" );
+
+    bench_offload::one_time_setup();
+
+    Object globals{ PyDict_New() };
+    PyDict_SetItemString( globals.p, "__builtins__", PyEval_GetBuiltins() );
+    globals[ "T" ] = bench_offload::type();
+    Object setup{ PyRun_String( "o = T()\n", Py_file_input, globals.p, globals.p ) };
+    throw_if_pyerr(TRACE);
+
+    auto run = [&]( const char* loop, long calls ) {
+        double ns = Bench::ns_per_op( 1, [&]{ Object r{ PyRun_String( loop, Py_file_input, globals.p, globals.p ) }; } ) / calls;
+        throw_if_pyerr(TRACE);
+        return ns;
+    };
+
+    std::cout << "    (" << ThreadPool::shared().size() << " workers)" << std::endl;
+
+    Bench::report( "work(0), called",                       run( "for _ in range(100000): o.work(0)\n",                             100000 ) );
+    Bench::report( "work(0), offloaded, result() each",     run( "for _ in range(10000): o.work_off(0).result()\n",                 10000 ) );
+    Bench::report( "work(0), offloaded, 1000 then gather",  run( "for _ in range(10):\n"
+                                                                 "    for f in [ o.work_off(0) for _ in range(1000) ]: f.result()\n", 10000 ) );
+    Bench::report( "work(1000000), called",                  run( "for _ in range(64): o.work(1000000)\n",                            64 ) );
+    Bench::report( "work(1000000), offloaded, then gather",  run( "for f in [ o.work_off(1000000) for _ in range(64) ]: f.result()\n", 64 ) );
+}
@@ -0,0 +1,113 @@
+/*
+  Benchmarks for the interpreter pool: the same script submitted many times over to 1, 2, 4 and 8 workers,
+  against running it in this interpreter one after another, and on as many threads of this interpreter.
+  A CPU-bound script only gets faster with a core per worker: the threads take turns at one GIL, the workers don't.
+  A script that waits (on a socket, a subprocess; here a sleep) overlaps its waits on any machine, in threads too,
+  unless what it waits in holds the GIL: then only the pool overlaps them.
+ */
+
+#include "ExtModule.hxx"
+#include "bench.hxx"
+
+#include <future>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace Py;
+
+
+namespace
+{
+    // "(x3.52)": how many times faster than one after another
+    std::string speedup( double serial, double ns )
+    {
+        std::ostringstream s;
+        s << " (x" << std::fixed << std::setprecision(2) << serial / ns << ")";
+        return s.str();
+    }
+
+    // ns per script, run 'scripts' times in this interpreter, one after another
+    double serially( const char* script, int scripts )
+    {
+        Object globals{ PyDict_New() };
+        PyDict_SetItemString( globals.p, "__builtins__", PyEval_GetBuiltins() );
+        double ns = Bench::ns_per_op( scripts, [&]{ Object r{ PyRun_String( script, Py_file_input, globals.p, globals.p ) }; } );
+        throw_if_pyerr(TRACE);
+        return ns;
+    }
+
+    // ns per script, shared out between 'threads' threads of this interpreter
+    double on_threads( const char* script, int scripts, size_t threads )
+    {
+        return Bench::ns_per_op( 1, [&]{
+            GilRelease unlocked;
+            std::vector<std::thread> running;
+            for( size_t t=0; t < threads; t++ )
+                running.emplace_back( [&, t]{
+                    GilAcquire locked;
+                    Object globals{ PyDict_New() };
+                    PyDict_SetItemString( globals.p, "__builtins__", PyEval_GetBuiltins() );
+                    for( size_t i=t; i < size_t(scripts); i += threads ) {
+                        Object r{ PyRun_String( script, Py_file_input, globals.p, globals.p ) };
+                        PyErr_Clear();
+                    }
+                } );
+            for( auto& t : running )
+                t.join();
+        } ) / scripts;
+    }
+
+    // ns per script, submitted all at once to a pool of 'workers'
+    double in_pool( const char* script, const char* expression, int scripts, size_t workers )
+    {
+        InterpreterPool pool{ workers };
+        return Bench::ns_per_op( 1, [&]{
+            std::vector< std::future<std::string> > results;
+            for( int i=0; i < scripts; i++ )
+                results.push_back( pool.submit( script, expression ) );
+            GilRelease unlocked;
+            for( auto& r : results )
+                r.get();
+        } ) / scripts;
+    }
+
+    void compare( const char* what, const char* script, const char* expression, int scripts )
+    {
+        std::cout << "    " << what << std::endl;
+        double here = serially( script, scripts );
+        Bench::report( "in this interpreter, one after another", here );
+
+        for( size_t workers : { 1, 2, 4, 8 } ) {
+            std::string n = std::to_string(workers);
+            double threads = on_threads( script, scripts, workers );
+            Bench::report( "  " + n + " thread" + ( workers > 1 ? "s" : "" ) + " of this interpreter" + speedup( here, threads ), threads );
+            double pool = in_pool( script, expression, scripts, workers );
+            Bench::report( "  pool, " + n + " worker" + ( workers > 1 ? "s" : "" ) + speedup( here, pool ), pool );
+        }
+    }
+}
+
+
+void bench_pool()
+{
+    Bench::heading( "an interpreter pool running scripts in parallel" );
+    std::cout << "    (" << std::thread::hardware_concurrency() << " hardware threads; ns per script)" << std::endl;
+
+    compare( "scripts that keep the CPU busy:",
+             "s = 0\n"
+             "for i in range( 200000 ): s += i * i\n", "s", 64 );
+
+    compare( "scripts that wait:",
+             "import time\n"
+             "time.sleep( 0.01 )\n", "", 32 );
+
+    // as an extension's call that doesn't let go of the GIL would (PyDLL keeps it held)
+    compare( "scripts that wait, holding the GIL:",
+             "import ctypes\n"
+             "ctypes.PyDLL( None ).usleep( 10000 )\n", "", 32 );
+
+    // what a round trip costs, for a script that does nothing
+    InterpreterPool pool{ 1 };
+    Bench::report( "pool, empty script, submit then get", Bench::ns_per_op( 2000, [&]{ pool.submit( "" ).get(); } ) );
+}
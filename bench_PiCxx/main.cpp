@@ -0,0 +1,56 @@
+#include "Base.hxx"
+
+void bench_objects();
+void bench_call();
+void bench_extobj();
+void bench_handlers();
+void bench_alloc();
+void bench_gil();
+void bench_offload();
+void bench_callbacks();
+void bench_pool();
+
+int main(int argc, const char * argv[])
+{
+    Py_Initialize();
+
+    // Object footprint, refcount traffic, element access, iteration
+    if ((1))
+        bench_objects();
+
+    // tuple-building calls versus vectorcall
+    if ((1))
+        bench_call();
+
+    // Python calling C++ extension-object methods
+    if ((1))
+        bench_extobj();
+
+    // the per-call cost of a NewStyle handler, against the C API
+    if ((1))
+        bench_handlers();
+
+    // creating and destroying extension objects, with and without free lists
+    if ((1))
+        bench_alloc();
+
+    // Python threads calling C++ methods, with and without the GIL
+    if ((1))
+        bench_gil();
+
+    // offloaded methods on the thread pool
+    if ((1))
+        bench_offload();
+
+    // events from C++ threads into Python, per event and batched
+    if ((1))
+        bench_callbacks();
+
+    // scripts run in parallel by an interpreter pool, by number of workers
+    if ((1))
+        bench_pool();
+
+    Py_Finalize();
+
+    return 0;
+}
@@ -5,8 +5,15 @@
 #endif
 
 #include "ExtModule.hxx"
+#include "test_assert.hxx"
 
 #include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
 
 // = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
 
@@ -55,6 +62,37 @@ public:
         register_method< & new_style_class::f1_varargs    >( "func_varargs"   , "docs for func_varargs"   ) ;
         register_method< & new_style_class::f2_keyword    >( "func_keyword"   , "docs for func_keyword"   ) ;
         register_method< & new_style_class::f0_exception  >( "func_exception" , "docs for func_exception" ) ;
+
+        // typed signatures: arguments converted straight from the METH_FASTCALL array
+        register_method< & new_style_class::scaled_sum    >( "scaled_sum"     , "docs for scaled_sum"     ) ;
+        register_method< & new_style_class::describe      >( "describe" ) ;
+        register_method< & new_style_class::describe      >( "describe_again" ) ;
+        register_method< & new_style_class::halved        >( "describe_again" ) ;      // (an overload, for the test)
+        register_method< & new_style_class::plot          >( "plot", { arg("x"), arg("y") = 0, arg("color") = "red", kw_only, arg("width") = 1.5 }, "docs for plot" ) ;
+        register_method< & new_style_class::plot          >( "plot_blue", { arg("x"), arg("y") = 1, arg("color") = "blue", kw_only, arg("width") = 2.0 } ) ;
+    }
+
+    std::string plot( int x, int y, const std::string& color, double width )
+    {
+        return std::to_string(x) + "," + std::to_string(y) + "," + color + "," + std::to_string(width);
+    }
+
+    double scaled_sum( int n, const std::string& unit, std::span<const double> xs )
+    {
+        double sum = 0;
+        for( double x : xs )
+            sum += x;
+        return n * sum + ( unit == "k" ? 1000 : 0 );
+    }
+
+    double halved( double x ) const { return x / 2; }
+
+    std::string describe( std::string_view name, const std::vector<long>& counts, bool loud ) const
+    {
+        std::string s{ name };
+        for( long c : counts )
+            s += ":" + std::to_string(c);
+        return loud ? s + "!" : s;
     }
 
 
@@ -114,6 +152,113 @@ public:
 
 // = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
 
+// a small value-like new-style class, constructed inside its own Python object
+class inline_point: public NewStyle< inline_point >
+{
+public:
+    static constexpr bool inline_storage = true;
+
+    static int alive;
+
+    double x, y;
+    const int serial;
+    Object tag{ (PyObject*)nullptr };
+
+    inline_point( Bridge* self, const Tuple& args, const Dict& kwds )
+        : NewStyle< inline_point >::NewStyle( self, args, kwds )
+        , x{ args.size() > 0 ? static_cast<double>( args[0] ) : 0 }
+        , y{ args.size() > 1 ? static_cast<double>( args[1] ) : 0 }
+        , serial{ ++alive }
+    { }
+
+    virtual ~inline_point() { alive--; }
+
+    static void setup()
+    {
+        typeobject().setName( "inline_point" );
+        typeobject().supportWeakrefs();
+        register_method< & inline_point::norm2 >( "norm2" );
+        register_member< & inline_point::x >( "x" );
+        register_member< & inline_point::y >( "y", "docs for y" );
+        register_member< & inline_point::serial >( "serial" );
+        register_member< & inline_point::tag >( "tag" );
+        register_property< & inline_point::norm2 >( "r2" );
+        register_method< & inline_point::where >( "where" );
+    }
+
+    double norm2() const { return x*x + y*y; }
+
+    // the C++ object's address relative to its Python object
+    long where() { return static_cast<long>( reinterpret_cast<char*>(this) - reinterpret_cast<char*>( selfPtr() ) ); }
+};
+
+int inline_point::alive = 0;
+
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+// holds Objects that may lead back to itself: the cycle collector has to see them
+class gc_holder: public NewStyle< gc_holder >
+{
+public:
+    static int alive;
+
+    Object              m_callback{ None() };
+    std::vector<Object> m_items;
+
+    gc_holder( Bridge* self, const Tuple& args, const Dict& kwds )
+        : NewStyle< gc_holder >::NewStyle( self, args, kwds )
+    {
+        alive++;
+    }
+
+    virtual ~gc_holder() { alive--; }
+
+    static void setup()
+    {
+        typeobject().setName( "gc_holder" );
+        typeobject().supportGC();
+        register_method< & gc_holder::set_callback >( "set_callback" );
+        register_method< & gc_holder::add >( "add" );
+        register_member< & gc_holder::m_weight >( "weight" );
+        register_member< & gc_holder::m_callback >( "callback" );
+        register_property< & gc_holder::count >( "count" );
+        register_property< & gc_holder::label, & gc_holder::set_label >( "label" );
+    }
+
+    void gc_members( MemberVisitor& visit ) override
+    {
+        visit( m_callback );
+        for( auto& o : m_items )
+            visit( o );
+    }
+
+    void set_callback( const Object& f ) { m_callback = f; }
+    void add( const Object& o )          { m_items.push_back( o ); }
+
+    // (heap-stored C++ object: members go through tp_getset)
+    double      m_weight{ 1.5 };
+    std::string m_label{ "none" };
+
+    size_t count() const                        { return m_items.size(); }
+    const std::string& label() const            { return m_label; }
+    void set_label( const std::string& s )      { m_label = s; }
+};
+
+int gc_holder::alive = 0;
+
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+// an old-style class whose instances come from a free list
+class pooled_old: public OldStyle< pooled_old >
+{
+public:
+    static constexpr size_t free_list_cap = 2;
+
+    static void setup() { typeobject().setName( "pooled_old" );  typeobject().supportWeakrefs(); }
+};
+
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
 class old_style_class: public OldStyle< old_style_class >
 {
 public:
@@ -121,7 +266,9 @@ public:
     { }
 
     virtual ~old_style_class()
-    { }
+    {
+        gone = true;
+    }
 
     static void setup()
     {
@@ -132,8 +279,23 @@ public:
         register_method( "func_noargs" , & old_style_class::f0_noargs  );
         register_method( "func_varargs", & old_style_class::f1_varargs );
         register_method( "func_keyword", & old_style_class::f2_keyword );
+
+        register_method< & old_style_class::add >( "add" );
+        register_method< & old_style_class::slow_base >( "slow_base", offload );
     }
 
+    long add( long a, long b ) { return a + b; }
+
+    // offloaded: still there after 'ms', though Python may have dropped us
+    long slow_base( int ms )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds(ms) );
+        return gone ? -1 : m_base;
+    }
+
+    long m_base{ 7 };
+    static std::atomic<bool> gone;
+
     Object f0_noargs( void )
     {
         COUT_0( "f0_noargs" );
@@ -153,6 +315,8 @@ public:
     }
 };
 
+std::atomic<bool> old_style_class::gone{ false };
+
 // = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
 
 /*
@@ -165,6 +329,11 @@ public:
 class module_test_funcmapper : public ExtModule<module_test_funcmapper>
 {
 public:
+    static constexpr size_t thread_pool_size = 2;
+
+    // set by the test, for on_main_thread()
+    static std::thread::id& main_thread() { static std::thread::id id;  return id; }
+
     module_test_funcmapper() : ExtModule<module_test_funcmapper>::ExtModule{ "test_funcmapper", "doc for test_funcmapper" }
     {
         /*
@@ -232,6 +401,9 @@ public:
         COUT( "meaning_of_life: " << d["meaning_of_life"] << std::endl
                 << d << std::endl << "- - - - - - - " );
 
+        d["inline_point"] = inline_point::type();
+        d["gc_holder"] = gc_holder::type();
+
         // Add new_style_class a different way, for the sake of demonstration
         Object x = new_style_class::type();
         d["new_style_class"] = x;
@@ -250,12 +422,48 @@ public:
     {
         register_method("old_style_class", &module_test_funcmapper::factory_old_style_class,  "documentation for old_style_class()");
         register_method("func"           , &module_test_funcmapper::func,                     "documentation for func()");
+        register_method< &module_test_funcmapper::twice >( "twice" );
+        register_method< &module_test_funcmapper::log   >( "log" );
+
+        // overloads, tried in this order
+        register_method< &module_test_funcmapper::transform_int    >( "transform" );
+        register_method< &module_test_funcmapper::transform_float  >( "transform" );
+        register_method< &module_test_funcmapper::transform_point  >( "transform" );
+        register_method< &module_test_funcmapper::transform_list   >( "transform" );
+        register_method< &module_test_funcmapper::transform_int    >( "transform_int" );     // ...and one of them under its own name too
+
+        // without the GIL
+        register_method< &module_test_funcmapper::gil_held         >( "gil_held" );
+        register_method< &module_test_funcmapper::gil_held_nogil   >( "gil_held_nogil", nogil );
+        register_method< &module_test_funcmapper::wait_for_flag    >( "wait_for_flag", nogil );
+        register_method< &module_test_funcmapper::wait_holding_gil >( "wait_holding_gil" );
+        register_method< &module_test_funcmapper::set_flag         >( "set_flag" );
+        register_method< &module_test_funcmapper::checked_sqrt     >( "checked_sqrt", { arg("x"), arg("scale") = 1.0 }, nogil );
+
+        // on the thread pool
+        register_method< &module_test_funcmapper::sum_below        >( "sum_below", offload );
+        register_method< &module_test_funcmapper::sum_below        >( "sum_below_async", offload_async );
+        register_method< &module_test_funcmapper::on_main_thread   >( "on_main_thread", offload );
+        register_method< &module_test_funcmapper::count_chars      >( "count_chars", offload );
+        register_method< &module_test_funcmapper::fail_later       >( "fail_later", offload );
+
+        // events from C++ threads
+        register_method< &module_test_funcmapper::feed             >( "feed" );
+        register_method< &module_test_funcmapper::feed_drain       >( "feed_drain" );
+        register_method< &module_test_funcmapper::feed_queued      >( "feed_queued" );
+        register_method< &module_test_funcmapper::feed_drains      >( "feed_drains" );
+        register_method< &module_test_funcmapper::feed_add_reader  >( "feed_add_reader" );
+        register_method< &module_test_funcmapper::feed_remove_reader >( "feed_remove_reader" );
+        register_method< &module_test_funcmapper::feed_close       >( "feed_close" );
         
         // MARKER_STARTUP___3 one_time_setup() on each extention class
         // For every custom PythonType extension object, invoke its one-time setup
         // which creates a new PyTypeObject and registers it with the Python runtime.
         old_style_class::one_time_setup();
         new_style_class::one_time_setup();
+        inline_point::one_time_setup();
+        pooled_old::one_time_setup();
+        gc_holder::one_time_setup();
         // ^ foo:one_time_setup() requires foo to implement a static 'foo::setup()'
         //    
     }
@@ -266,6 +474,76 @@ public:
 
 private:
 
+    static double twice( double x ) { return 2 * x; }
+
+    int m_logged = 0;
+    void log( const char* ) { m_logged++; }
+
+    std::string transform_int( int n )                              { return "int " + std::to_string(n); }
+    std::string transform_float( double )                           { return "float"; }
+    std::string transform_point( double, double )                   { return "point"; }
+    std::string transform_list( const std::vector<double>& xs )     { return "list of " + std::to_string( xs.size() ); }
+
+    static bool gil_held()          { return PyGILState_Check(); }
+    static bool gil_held_nogil()    { return PyGILState_Check(); }
+
+    // waits (up to ms) for another thread to set the flag
+    std::atomic<bool> m_flag{ false };
+    void set_flag( bool b ) { m_flag = b; }
+
+    bool wait_for_flag( int ms )
+    {
+        auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds( ms );
+        while( ! m_flag && std::chrono::steady_clock::now() < until )
+            std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+        return m_flag;
+    }
+    bool wait_holding_gil( int ms ) { return wait_for_flag( ms ); }
+
+    static long long sum_below( int n )
+    {
+        long long s = 0;
+        for( int i=0; i < n; i++ )
+            s += i;
+        return s;
+    }
+
+    static bool on_main_thread() { return std::this_thread::get_id() == main_thread(); }
+
+    size_t count_chars( std::string s ) const { return s.size(); }
+
+    static void fail_later( int code ) { THROW( "fail_later: " + std::to_string(code) ); }
+
+    // 'threads' threads each push t*1000000 + 0, 1, 2... for the callback, the GIL held by us meanwhile
+    std::unique_ptr< CallbackQueue<long long> > m_feed;
+
+    void feed( Object callback, int wake, bool as_list, int batch, int threads, int per_thread )
+    {
+        m_feed.reset( new CallbackQueue<long long>{ callback, static_cast<CallbackWake>( wake ),
+                                                    as_list ? CallbackDelivery::batch : CallbackDelivery::each, static_cast<size_t>( batch ) } );
+        std::vector< std::thread > producers;
+        for( int t=0; t < threads; t++ )
+            producers.emplace_back( [this, t, per_thread] {
+                for( int i=0; i < per_thread; i++ )
+                    m_feed->push( t * 1000000LL + i );
+            } );
+        for( auto& p : producers )
+            p.join();
+    }
+    size_t feed_drain()                         { return m_feed->drain(); }
+    size_t feed_queued()                        { return m_feed->size(); }
+    size_t feed_drains()                        { return m_feed->drains(); }
+    void feed_add_reader( Object loop )         { m_feed->add_reader( loop ); }
+    void feed_remove_reader( Object loop )      { m_feed->remove_reader( loop ); }
+    void feed_close()                           { m_feed.reset(); }
+
+    static double checked_sqrt( double x, double scale )
+    {
+        if( x < 0 )
+            THROW( "checked_sqrt: negative" );      // (constructing an Exception doesn't need the GIL)
+        return scale * std::sqrt( x );
+    }
+
     Object func( const Tuple& a, const Dict& k )
     {
         COUT_AK( "func", a, k );
@@ -325,12 +603,14 @@ private:
 extern "C" EXPORT_SYMBOL PyObject* PyInit_test_funcmapper()
 {
     /*
-        This static reset() method:
-            - creates a new instance of our module object,
+        This static init() method returns the module's definition (multi-phase init, PEP 489).
+        Python then makes the module object, and has us fill it:
+            - creates a new instance of our module object, kept in the module object's state,
             - fires the static register_methods_and_classes() method, which our module object MUST implement,
-            - creates a module PyObject, returning a wrapped pointer (which we unwrap with the overloaded * operator)
+              (once per session: every interpreter's module gets its own instance, and its own types)
+        The older reset() does it all at once, returning the module PyObject: one instance for the process.
      */
-    return *module_test_funcmapper::reset(); // jumpnext
+    return module_test_funcmapper::init( "test_funcmapper" ); // jumpnext
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -365,6 +645,546 @@ void test_funcmapper()
         // "import test_funcmapper" in this file calls PyInit_test_funcmapper
         Py::run_file( "./py/test_funcmapper.py" );
 
+        // "alpha"_py was first used by test_ob(), before a Py_Finalize: it is interned again for this runtime
+        test_assert( "literal interned in this runtime", true, "alpha"_py.name().is( Object{ PyUnicode_InternFromString("alpha") } ) );
+
+        // a slot given back is taken by the next Interned, which makes its own str there rather than reusing the old one's
+        {
+            size_t used;
+            {
+                Interned gone{ "gone" };
+                gone.name();
+                used = InterpreterObjects::current().size();
+            }
+            Interned next{ "next" };
+            test_assert( "slot reused", std::string{"next"}, next.name().as_string() );
+            test_assert( "table doesn't grow", used, InterpreterObjects::current().size() );
+        }
+
+        // old-style methods are bound once per instance, then handed out again
+        {
+            Object main_dict{ charge( PyModule_GetDict( PyImport_AddModule("__main__") ) ) };
+            Object module{ main_dict["test_funcmapper"] };
+
+            Object o{ module.call_method( "old_style_class"_py ) };
+            Object f{ o.getAttr( "func_noargs"_py ) };
+            test_assert( "old-style method is cached", true, f.is( o.getAttr( "func_noargs"_py ) ) );
+            test_assert( "cached method calls", true, f.call().isNone() );
+            test_assert( "instance holds the method", 2L, static_cast<long>( f.reference_count() ) );
+
+            o = None();
+            test_assert( "instance releases its methods", 1L, static_cast<long>( f.reference_count() ) );
+        }
+
+        // a new-style class with inline_storage: one allocation, the C++ object right after the Bridge
+        {
+            Object main_dict{ charge( PyModule_GetDict( PyImport_AddModule("__main__") ) ) };
+            Object type{ main_dict["test_funcmapper"]->getAttr( "inline_point"_py ) };
+
+            Object p{ type.call( 3.0, 4.0 ) };
+            test_assert( "inline object alive", 1, inline_point::alive );
+            test_assert( "inline method", 25.0, static_cast<double>( p.call_method( "norm2"_py ) ) );
+            test_assert( "inline offset", static_cast<long>( inline_offset<inline_point>() ), static_cast<long>( p.call_method( "where"_py ) ) );
+            test_assert( "basicsize holds it", static_cast<long>( inline_offset<inline_point>() + sizeof(inline_point) ),
+                         static_cast<long>( type.getAttr( "__basicsize__"_py ) ) );
+
+            // a Python subclass adds a __dict__ after tp_basicsize, the C++ object stays put
+            Object ns{ PyDict_New() };
+            ns[ "Base" ] = type;
+            Object ran{ PyRun_String( "class Sub(Base):\n    pass\ns = Sub(1.0, 2.0)\ns.tag = 'sub'\n", Py_file_input, ns.p, ns.p ) };
+            throw_if_pyerr(TRACE);
+            Object sub{ ns["s"] };
+            test_assert( "subclass method", 5.0, static_cast<double>( sub.call_method( "norm2"_py ) ) );
+            test_assert( "subclass dict", std::string{"sub"}, sub.getAttr( "tag"_py ).as_string() );
+            test_assert( "subclass offset", static_cast<long>( inline_offset<inline_point>() ), static_cast<long>( sub.call_method( "where"_py ) ) );
+
+            p = None();
+            sub = None();
+            ns = None();
+            ran = None();
+            PyGC_Collect();
+            test_assert( "destroyed in place", 0, inline_point::alive );
+        }
+
+        // data members and properties: tp_members with inline_storage, tp_getset otherwise
+        {
+            Object main_dict{ charge( PyModule_GetDict( PyImport_AddModule("__main__") ) ) };
+            Object ns{ PyDict_New() };
+            ns[ "Point" ] = main_dict["test_funcmapper"]->getAttr( "inline_point"_py );
+            ns[ "Holder" ] = main_dict["test_funcmapper"]->getAttr( "gc_holder"_py );
+
+            auto run = [&] ( const char* code ) {
+                Object r{ PyRun_String( code, Py_eval_input, ns.p, ns.p ) };
+                PyObject *type, *value, *trace;
+                PyErr_Fetch( &type, &value, &trace );
+                Object t{ type }, v{ value }, tb{ trace };
+                return v.isNull() ? r.repr().as_string() : std::string{ PyExceptionClass_Name(type) } + ": " + v.as_string();
+            };
+            Object made{ PyRun_String( "p = Point(3.0, 4.0)\nh = Holder()\n", Py_file_input, ns.p, ns.p ) };
+            throw_if_pyerr(TRACE);
+
+            test_assert( "member read",             std::string{"3.0"},                 run( "p.x" ) );
+            test_assert( "member write",            std::string{"None"},                run( "setattr(p, 'x', 6)" ) );
+            test_assert( "...reaches the C++ field", std::string{"52.0"},               run( "p.norm2()" ) );
+            test_assert( "read-only property",      std::string{"52.0"},                run( "p.r2" ) );
+            test_assert( "...can't be set",         std::string{"AttributeError: attribute 'r2' of 'inline_point' objects is not writable"}, run( "setattr(p, 'r2', 1)" ) );
+            test_assert( "tp_members",              std::string{"'member_descriptor'"}, run( "type(Point.__dict__['x']).__name__" ) );
+            test_assert( "member doc",              std::string{"'docs for y'"},        run( "Point.y.__doc__" ) );
+            test_assert( "const field is read-only", std::string{"AttributeError: readonly attribute"}, run( "setattr(p, 'serial', 1)" ) );
+            test_assert( "member type checked",     std::string{"TypeError: must be real number, not str"}, run( "setattr(p, 'y', 'a')" ) );
+            test_assert( "unset Object member",     std::string{"AttributeError: 'inline_point' object has no attribute 'tag'"}, run( "p.tag" ) );
+            test_assert( "Object member",           std::string{"[1]"},                 run( "setattr(p, 'tag', [1]) or p.tag" ) );
+
+            test_assert( "tp_getset",               std::string{"'getset_descriptor'"}, run( "type(Holder.__dict__['weight']).__name__" ) );
+            test_assert( "getset member",           std::string{"2.0"},                 run( "setattr(h, 'weight', 2) or h.weight" ) );
+            test_assert( "getset type checked",     std::string{"TypeError: attribute must be float, not str"}, run( "setattr(h, 'weight', 'a')" ) );
+            test_assert( "property",                std::string{"'abc'"},               run( "setattr(h, 'label', 'abc') or h.label" ) );
+            test_assert( "property without setter", std::string{"0"},                   run( "h.count" ) );
+            test_assert( "can't delete",            std::string{"AttributeError: can't delete this attribute"}, run( "delattr(h, 'label')" ) );
+            test_assert( "no getattro override, no trampoline", true, ExtObject< inline_point >::table()->tp_getattro == PyObject_GenericGetAttr );
+        }
+
+        // weak references, from Python and from C++
+        {
+            Object main_dict{ charge( PyModule_GetDict( PyImport_AddModule("__main__") ) ) };
+            Object ns{ PyDict_New() };
+            ns[ "Point" ] = main_dict["test_funcmapper"]->getAttr( "inline_point"_py );
+
+            Object ran{ PyRun_String(
+                "import weakref\n"
+                "class Sub(Point):\n"
+                "    pass\n"
+                "cache = weakref.WeakValueDictionary()\n"
+                "p = Point(3.0, 4.0)\n"
+                "cache['p'] = p\n"
+                "cache['s'] = s = Sub(1.0, 0.0)\n"
+                "died = []\n"
+                "r = weakref.ref(p, lambda r: died.append(1))\n"
+                "ok = r() is p and cache['s'] is s\n", Py_file_input, ns.p, ns.p ) };
+            throw_if_pyerr(TRACE);
+            test_assert( "weakref.ref and WeakValueDictionary", true, ns["ok"]->as_bool() );
+
+            WeakRef<inline_point> w{ ns["p"] };
+            Object locked{ w.lock() };
+            test_assert( "WeakRef locks", true, locked.is( ns["p"] ) );
+            test_assert( "...to the C++ object", 25.0, WeakRef<inline_point>::cxx(locked)->norm2() );
+            locked = None();
+
+            Object gone{ PyRun_String( "del p, s\nn = len(cache)\n", Py_file_input, ns.p, ns.p ) };
+            test_assert( "entries drop with the objects", 0L, static_cast<long>( ns["n"] ) );
+            test_assert( "callback ran", 1L, static_cast<long>( ns["died"]->size() ) );
+            test_assert( "WeakRef expired", true, w.expired() );
+            test_assert( "...locks to null", true, w.lock().isNull() );
+            test_assert( "no points left", 0, inline_point::alive );
+
+            Object old{ new pooled_old };
+            WeakRef<pooled_old> wo{ old };
+            test_assert( "old-style WeakRef", true, wo.lock().is( old ) );
+            old = None();
+            test_assert( "old-style WeakRef expired", true, wo.expired() );
+        }
+
+        // cycles through an extension object's Object members get collected
+        {
+            Object main_dict{ charge( PyModule_GetDict( PyImport_AddModule("__main__") ) ) };
+            Object ns{ PyDict_New() };
+            ns[ "Holder" ] = main_dict["test_funcmapper"]->getAttr( "gc_holder"_py );
+
+            Object ran{ PyRun_String(
+                "import gc\n"
+                "class Sub(Holder):\n"
+                "    pass\n"
+                "def cycles(n):\n"
+                "    for i in range(n):\n"
+                "        h = Holder()\n"
+                "        h.set_callback( lambda: h )\n"       // through a closure
+                "        k = Holder()\n"
+                "        k.add( [k, 1] )\n"                    // through a list
+                "        s = Sub()\n"
+                "        s.me = s\n"                           // through a subclass __dict__ ...
+                "        s.add( s )\n"                         // ... and a member
+                "cycles(1000)\n"
+                "gc.collect()\n", Py_file_input, ns.p, ns.p ) };
+            throw_if_pyerr(TRACE);
+            test_assert( "cycles collected", 0, gc_holder::alive );
+
+            Object again{ PyRun_String( "cycles(1000)\ngc.collect()\n", Py_file_input, ns.p, ns.p ) };
+            test_assert( "...every time", 0, gc_holder::alive );
+
+            Object h{ ns["Holder"]->call() };
+            h.call_method( "add"_py, h );
+            test_assert( "gc sees the object", true, PyObject_GC_IsTracked( h.p ) == 1 );
+            h = None();
+            PyGC_Collect();
+            test_assert( "collected from C++", 0, gc_holder::alive );
+        }
+
+        // free lists: freed instances are kept up to the cap, and handed out again
+        {
+            FreeList& list = pooled_old::instance_free_list();
+            list.set_cap(0);                // (empty it)
+            list.set_cap(2);
+            list.reset_stats();
+            {
+                Object a{ new pooled_old }, b{ new pooled_old }, c{ new pooled_old };
+            }
+            test_assert( "old-style: 3 freed",          size_t{3}, list.stats().frees );
+            test_assert( "...2 kept",                   size_t{2}, list.stats().kept );
+            test_assert( "...1 released",               size_t{1}, list.stats().released );
+
+            PyObject* kept = nullptr;
+            {
+                Object d{ new pooled_old };
+                kept = d.p;
+                test_assert( "old-style: reused",       size_t{1}, list.stats().reused );
+                test_assert( "...is a live instance",   true, pooled_old::check(d) );
+            }
+            Object e{ new pooled_old };
+            test_assert( "same block again",            kept, e.p );
+
+            list.set_cap(0);
+            e = None();
+            test_assert( "cap 0 keeps nothing",         size_t{0}, list.stats().kept );
+        }
+
+        // typed signatures, on a module, an old-style class and a new-style class
+        {
+            Object main_dict{ charge( PyModule_GetDict( PyImport_AddModule("__main__") ) ) };
+            Object module{ main_dict["test_funcmapper"] };
+
+            test_assert( "free function",   5.0, static_cast<double>( module.call_method( "twice"_py, 2.5 ) ) );
+            test_assert( "int for double",  4.0, static_cast<double>( module.call_method( "twice"_py, 2 ) ) );
+            test_assert( "void returns None", true, module.call_method( "log"_py, "hi" ).isNone() );
+
+            Object o{ module.call_method( "old_style_class"_py ) };
+            test_assert( "old-style typed", 7L, static_cast<long>( o.call_method( "add"_py, 3, 4 ) ) );
+
+            Object n{ module.getAttr( "new_style_class"_py ).call() };
+            test_assert( "span from list", 6.0, static_cast<double>( n.call_method( "scaled_sum"_py, 2, "", Object('L', 1.0, 2.0) ) ) );
+
+            Object arr{ Object{ PyImport_ImportModule("array") }.call_method( "array"_py, "d", Object('L', 1.0, 2.0, 3.0) ) };
+            test_assert( "span over a buffer", 1012.0, static_cast<double>( n.call_method( "scaled_sum"_py, 2, "k", arr ) ) );
+            test_assert( "vector/string_view/bool", std::string{"x:1:2!"},
+                         static_cast<std::string>( n.call_method( "describe"_py, "x", Object('T', 1, 2), true ) ) );
+
+            // (raw C-API calls here, as the throwing wrappers print and clear the error in debug builds)
+            auto error_of = [] ( PyObject* result ) {
+                Object held{ result };
+                PyObject *type, *value, *trace;
+                PyErr_Fetch( &type, &value, &trace );
+                Object t{ type }, v{ value }, tb{ trace };
+                return v.isNull() ? std::string{} : v.as_string();
+            };
+
+            test_assert( "wrong type names the argument", std::string{"scaled_sum() argument 2 must be str, not int"},
+                         error_of( PyObject_CallMethod( n.p, "scaled_sum", "iiO", 1, 2, Object('L').p ) ) );
+            test_assert( "wrong count", std::string{"add() takes 2 positional arguments but 1 was given"},
+                         error_of( PyObject_CallMethod( o.p, "add", "i", 1 ) ) );
+            // keyword binding against the registered parameter spec
+            test_assert( "positional + defaults", std::string{"1,0,red,1.500000"},
+                         static_cast<std::string>( n.call_method( "plot"_py, 1 ) ) );
+            test_assert( "keywords in any order", std::string{"1,2,blue,3.000000"},
+                         static_cast<std::string>( n.call_method( "plot"_py, kw("width", 3.0), kw("color", "blue"), kw("y", 2), kw("x", 1) ) ) );
+
+            Object kwargs{ 'D', "x", 5, "width", 2 };
+            test_assert( "runtime (non-interned) keywords", std::string{"5,0,red,2.000000"},
+                         static_cast<std::string>( n.getAttr( "plot"_py )( Object{'T'}, kwargs ) ) );
+
+            test_assert( "kw_only refuses positionals", std::string{"plot() takes at most 3 positional arguments (4 given)"},
+                         error_of( PyObject_CallMethod( n.p, "plot", "iisd", 1, 2, "c", 1.0 ) ) );
+            test_assert( "missing required", std::string{"plot() missing required argument 'x' (pos 1)"},
+                         error_of( PyObject_CallMethod( n.p, "plot", "" ) ) );
+            test_assert( "unexpected keyword", std::string{"plot() got an unexpected keyword argument 'z'"},
+                         error_of( PyObject_Call( n.getAttr( "plot"_py ).p, Object{'T', 1}.p, Object{'D', "z", 1}.p ) ) );
+            test_assert( "multiple values", std::string{"plot() got multiple values for argument 'x'"},
+                         error_of( PyObject_Call( n.getAttr( "plot"_py ).p, Object{'T', 1}.p, Object{'D', "x", 1}.p ) ) );
+
+            Object inspect{ PyImport_ImportModule("inspect") };
+            test_assert( "text signature", std::string{"(x, y=0, color='red', *, width=1.5)"},
+                         inspect.call_method( "signature"_py, n.getAttr( "plot"_py ) ).as_string() );
+
+            // the same function with another spec under another name: each name binds with its own
+            test_assert( "second spec",             std::string{"1,1,blue,2.000000"}, static_cast<std::string>( n.call_method( "plot_blue"_py, 1 ) ) );
+            test_assert( "...first spec unchanged", std::string{"1,0,red,1.500000"},  static_cast<std::string>( n.call_method( "plot"_py, 1 ) ) );
+            test_assert( "...its own error",        std::string{"plot_blue() got an unexpected keyword argument 'z'"},
+                         error_of( PyObject_Call( n.getAttr( "plot_blue"_py ).p, Object{'T', 1}.p, Object{'D', "z", 1}.p ) ) );
+
+            test_assert( "overflow", std::string{"Python int too large for the C++ parameter type"},
+                         error_of( PyObject_CallMethod( n.p, "scaled_sum", "Lss", 1LL << 40, "", "" ) ) );
+
+            // overloads: the first registered that accepts the arguments (repeats go through the type cache)
+            auto transform = [&] ( auto... args ) { return static_cast<std::string>( module.call_method( "transform"_py, args... ) ); };
+            test_assert( "overload by type",        std::string{"int 3"},     transform( 3 ) );
+            test_assert( "overload, cached",        std::string{"int 4"},     transform( 4 ) );
+            test_assert( "overload by type, float", std::string{"float"},     transform( 1.5 ) );
+            test_assert( "overload by count",       std::string{"point"},     transform( 1, 2.5 ) );
+            test_assert( "overload, sequence",      std::string{"list of 2"}, transform( Object('L', 1.0, 2.0) ) );
+            test_assert( "overload, cache again",   std::string{"int 5"},     transform( 5 ) );
+            test_assert( "out of range for int",    std::string{"float"},     transform( 1LL << 40 ) );
+            test_assert( "...is not cached",        std::string{"int 6"},     transform( 6 ) );
+            std::string candidates{ "; candidates are transform(int), transform(float), transform(float, float), transform(a sequence)" };
+            test_assert( "no overload accepts", "transform(): no overload accepts (str)" + candidates,
+                         error_of( PyObject_CallMethod( module.p, "transform", "s", "x" ) ) );
+            test_assert( "cached overload refuses the values", "transform(): no overload accepts (list)" + candidates,
+                         error_of( PyObject_CallMethod( module.p, "transform", "O", Object('L', "a").p ) ) );
+
+            // one function under two names: the second registration leaves the first's overloads alone
+            test_assert( "under its own name",      std::string{"int 7"},     static_cast<std::string>( module.call_method( "transform_int"_py, 7 ) ) );
+            test_assert( "...still overloaded",     std::string{"float"},     transform( 2.5 ) );
+            test_assert( "new-style, second name",  std::string{"y:3"},
+                         static_cast<std::string>( n.call_method( "describe_again"_py, "y", Object('T', 3), false ) ) );
+            test_assert( "...with its own overloads", 1.5, static_cast<double>( n.call_method( "describe_again"_py, 3.0 ) ) );
+            test_assert( "errors name the one called", std::string{"describe() takes 3 positional arguments but 1 was given"},
+                         error_of( PyObject_CallMethod( n.p, "describe", "d", 3.0 ) ) );
+            test_assert( "...either one",             std::string{"transform_int() argument 1 must be int, not str"},
+                         error_of( PyObject_CallMethod( module.p, "transform_int", "s", "x" ) ) );
+
+            // nogil: the body runs with the GIL released, so another Python thread gets to run meanwhile
+            test_assert( "GIL held in a method",        true,  static_cast<bool>( module.call_method( "gil_held"_py ) ) );
+            test_assert( "...and released with nogil",  false, static_cast<bool>( module.call_method( "gil_held_nogil"_py ) ) );
+            test_assert( "...and held again after",     1, PyGILState_Check() );
+
+            Object ns{ PyDict_New() };
+            ns[ "m" ] = module;
+            auto wait_on_thread = [&] ( const char* wait ) {
+                Object r{ PyRun_String( ( std::string{
+                    "import threading, time\n"
+                    "t = threading.Thread( target=lambda: ( time.sleep(0.02), m.set_flag(True) ) )\n"
+                    "t.start()\n"
+                    "r = " } + wait + "\n"
+                    "t.join()\n"
+                    "m.set_flag(False)\n" ).c_str(), Py_file_input, ns.p, ns.p ) };
+                throw_if_pyerr(TRACE);
+                return static_cast<bool>( ns["r"] );
+            };
+            test_assert( "holding the GIL, the thread can't run",   false, wait_on_thread( "m.wait_holding_gil(200)" ) );
+            test_assert( "with nogil, it can",                      true,  wait_on_thread( "m.wait_for_flag(5000)" ) );
+
+            test_assert( "nogil with keywords",         6.0, static_cast<double>( Object{ PyRun_String( "m.checked_sqrt(9, scale=2)", Py_eval_input, ns.p, ns.p ) } ) );
+            test_assert( "exception thrown without the GIL", std::string{"PiCxx Exception:checked_sqrt: negative"},
+                         error_of( PyObject_CallMethod( module.p, "checked_sqrt", "d", -1.0 ) ) );
+            test_assert( "...GIL held again",           1, PyGILState_Check() );
+
+            // offload: the call returns a future at once, the body runs on the thread pool
+            module_test_funcmapper::main_thread() = std::this_thread::get_id();
+            auto eval = [&] ( const char* code ) {
+                Object r{ PyRun_String( code, Py_eval_input, ns.p, ns.p ) };
+                throw_if_pyerr(TRACE);
+                return r;
+            };
+            test_assert( "pool sized by the module",    size_t{2},  ThreadPool::shared().size() );
+            {
+                // resizing a running pool is refused: it would join a worker waiting for the GIL we hold
+                std::atomic<bool> took{ false };
+                ThreadPool::shared().submit( [&took] { GilAcquire locked;  took = true; } );
+                test_assert( "running pool keeps its size", false, ThreadPool::shared().set_size( 3 ) );
+                test_assert( "...which is still 2",          size_t{2}, ThreadPool::shared().size() );
+                {
+                    GilRelease unlocked;
+                    ThreadPool::shared().wait_idle();
+                }
+                test_assert( "...and its task ran",          true, static_cast<bool>( took ) );
+
+                // tasks on the shared pool's workers submitting to a pool of one
+                ThreadPool single{ 1 };
+                test_assert( "a pool that hasn't started can be sized", true, single.set_size( 1 ) );
+                std::atomic<int> ran{ 0 };
+                {
+                    GilRelease unlocked;
+                    for( int i=0; i < 8; i++ )
+                        ThreadPool::shared().submit( [&single, &ran] { single.submit( [&ran] { ran++; } ); } );
+                    ThreadPool::shared().wait_idle();
+                    single.wait_idle();
+                }
+                test_assert( "submitting from another pool's worker", 8, static_cast<int>( ran ) );
+            }
+            test_assert( "offload returns a future",    std::string{"Future"}, static_cast<std::string>( eval( "type(m.sum_below(10)).__name__" ) ) );
+            test_assert( "...with the result",          4950LL,     static_cast<long long>( eval( "m.sum_below(100).result(5)" ) ) );
+            test_assert( "...computed off the main thread", false,  static_cast<bool>( eval( "m.on_main_thread().result(5)" ) ) );
+            test_assert( "...with a copy of the str",   size_t{5},  static_cast<size_t>( static_cast<long>( eval( "m.count_chars('ab' + 'cde').result(5)" ) ) ) );
+            test_assert( "many at once",                true,       static_cast<bool>( eval(
+                             "[ f.result(5) for f in [ m.sum_below(n) for n in range(200) ] ] == [ n*(n-1)//2 for n in range(200) ]" ) ) );
+            test_assert( "exception set on the future", std::string{"RuntimeError: PiCxx Exception:fail_later: 7"},
+                         static_cast<std::string>( eval( "( lambda e: type(e).__name__ + ': ' + str(e) )( m.fail_later(7).exception(5) )" ) ) );
+            old_style_class::gone = false;
+            test_assert( "instance dropped before result()", 7L, static_cast<long>( eval(
+                             "( lambda o: ( lambda f: ( o.clear(), f )[1] )( o[0].slow_base(50) ) )( [ m.old_style_class() ] ).result(5)" ) ) );
+            test_assert( "...then freed",               true,       static_cast<bool>( old_style_class::gone ) );
+            test_assert( "bad argument raised at once", std::string{"sum_below() argument 1 must be int, not str"},
+                         error_of( PyObject_CallMethod( module.p, "sum_below", "s", "x" ) ) );
+            test_assert( "...named as called",          std::string{"sum_below_async() argument 1 must be int, not str"},
+                         error_of( PyObject_CallMethod( module.p, "sum_below_async", "s", "x" ) ) );
+            Object awaited{ PyRun_String(
+                "import asyncio\n"
+                "async def both():\n"
+                "    return await asyncio.gather( m.sum_below_async(10), m.sum_below_async(20) )\n"
+                "sums = asyncio.run( both() )\n", Py_file_input, ns.p, ns.p ) };
+            throw_if_pyerr(TRACE);
+            test_assert( "offload_async, awaited",      true,       static_cast<bool>( eval( "sums == [45, 190]" ) ) );
+
+            // CallbackQueue: events pushed from C++ threads, delivered in batches
+            Object fed{ PyRun_String(
+                "import sys, time\n"
+                "def in_order( got, threads, per_thread ):\n"
+                "    return all( [ x for x in got if x // 1000000 == t ] == [ t*1000000 + i for i in range(per_thread) ] for t in range(threads) )\n"
+                "def wait_for( done, step ):\n"
+                "    until = time.monotonic() + 5\n"
+                "    while not done() and time.monotonic() < until: step()\n"
+                // manual: nothing happens until we drain
+                "got = []\n"
+                "m.feed( got.append, 3, False, 100, 2, 500 )\n"
+                "manual = ( m.feed_queued(), len(got), m.feed_drain(), len(got) )\n"
+                "while m.feed_drain(): pass\n"
+                "manual += ( m.feed_drains(), len(got), in_order( got, 2, 500 ) )\n"
+                // pending_call: the main thread drains between bytecodes
+                "got = []\n"
+                "m.feed( got.append, 0, False, 64, 4, 1000 )\n"
+                "wait_for( lambda: len(got) == 4000, lambda: None )\n"
+                "pending = ( len(got), m.feed_drains(), in_order( got, 4, 1000 ) )\n"
+                // a list per batch
+                "batches = []\n"
+                "m.feed( batches.append, 0, True, 64, 2, 500 )\n"
+                "wait_for( lambda: sum( map( len, batches ) ) == 1000, lambda: None )\n"
+                "listed = ( len(batches), max( map( len, batches ) ), in_order( [ x for b in batches for x in b ], 2, 500 ) )\n"
+                // the queue's thread, while we sleep
+                "got = []\n"
+                "m.feed( got.append, 2, False, 64, 2, 500 )\n"
+                "wait_for( lambda: len(got) == 1000, lambda: time.sleep( 0.001 ) )\n"
+                "threaded = ( len(got), in_order( got, 2, 500 ) )\n"
+                "m.feed_close()\n"
+                // a callable without vectorcall (the reused tuple), raising for one event
+                "class Keeper:\n"
+                "    def __init__( self ): self.got = []\n"
+                "    def __call__( self, x ):\n"
+                "        if x == 3: raise ValueError( 'three' )\n"
+                "        self.got.append( x )\n"
+                "unraisable = []\n"
+                "sys.unraisablehook = lambda u: unraisable.append( str( u.exc_value ) )\n"
+                "k = Keeper()\n"
+                "m.feed( k, 3, False, 100, 1, 6 )\n"
+                "m.feed_drain()\n"
+                "sys.unraisablehook = sys.__unraisablehook__\n"
+                "called = ( k.got, unraisable )\n"
+                // fd: an asyncio loop watching the eventfd
+                "async def on_loop():\n"
+                "    loop = asyncio.get_running_loop()\n"
+                "    done = loop.create_future()\n"
+                "    got = []\n"
+                "    def on_event( x ):\n"
+                "        got.append( x )\n"
+                "        if len(got) == 1000: done.set_result( None )\n"
+                "    m.feed( on_event, 1, False, 64, 2, 500 )\n"
+                "    m.feed_add_reader( loop )\n"
+                "    await asyncio.wait_for( done, 5 )\n"
+                "    m.feed_remove_reader( loop )\n"
+                "    return ( len(got), in_order( got, 2, 500 ) )\n"
+                "on_fd = asyncio.run( on_loop() )\n"
+                "m.feed_close()\n", Py_file_input, ns.p, ns.p ) };
+            throw_if_pyerr(TRACE);
+            test_assert( "callback queue, manual: queued, nothing delivered",  true, static_cast<bool>( eval( "manual[:2] == (1000, 0)" ) ) );
+            test_assert( "...a drain delivers one batch",                       true, static_cast<bool>( eval( "manual[2:4] == (100, 100)" ) ) );
+            test_assert( "...then the rest, in order",                          true, static_cast<bool>( eval( "manual[4:] == (10, 1000, True)" ) ) );
+            test_assert( "pending_call: all delivered, in order",               true, static_cast<bool>( eval( "pending[0] == 4000 and pending[2]" ) ) );
+            test_assert( "...in batches",                                       true, static_cast<bool>( eval( "63 <= pending[1] < 4000" ) ) );
+            test_assert( "batch delivery: lists of at most 'batch'",            true, static_cast<bool>( eval( "listed[1] <= 64 and listed[0] >= 16 and listed[2]" ) ) );
+            test_assert( "thread: delivered while we slept",                    true, static_cast<bool>( eval( "threaded == (1000, True)" ) ) );
+            test_assert( "callable without vectorcall, one raising",            true, static_cast<bool>( eval( "called == ( [0, 1, 2, 4, 5], ['three'] )" ) ) );
+            test_assert( "fd: drained by an asyncio reader",                    true, static_cast<bool>( eval( "on_fd == (1000, True)" ) ) );
+
+            // multi-phase init: the module, its C++ instance and its types are the interpreter's own
+            module_test_funcmapper* main_instance = module_test_funcmapper::instance( module );
+            PyTypeObject* main_type = ExtObject<new_style_class>::table();
+            test_assert( "module made by init()",       true, main_instance != nullptr );
+            test_assert( "...its def named as imported", std::string{"test_funcmapper"}, std::string{ PyModule_GetDef( module.p )->m_name } );
+            test_assert( "type is a heap type",         true, PyType_HasFeature( main_type, Py_TPFLAGS_HEAPTYPE ) != 0 );
+
+            PyThreadState* main_state = PyThreadState_Get();
+            Object main_alpha{ "alpha"_py.name() };
+            PyThreadState* sub = Py_NewInterpreter();
+            test_assert( "subinterpreter",              true, sub != nullptr );
+            {
+                Object sub_ns{ PyDict_New() };
+                PyDict_SetItemString( sub_ns.p, "__builtins__", PyEval_GetBuiltins() );
+                Object ran{ PyRun_String(
+                    "import test_funcmapper as m\n"
+                    "n = m.new_style_class()\n"
+                    "r = ( m.twice(21), n.scaled_sum( 2, 'm', [1.0, 2.0] ), type(n).__name__, n.plot( 1, width=2 ), m.transform(3), m.transform(1.5) )\n"
+                    // an offloaded call: the worker sets the result, and runs the callbacks, in this interpreter
+                    "import sys, threading\n"
+                    "done, seen = threading.Event(), []\n"
+                    "o = m.old_style_class()\n"
+                    "f = o.slow_base(50)\n"
+                    "f.add_done_callback( lambda f: ( seen.append( __import__('sys') is sys ), done.set() ) )\n"
+                    "offloaded = ( f.exception(5), done.wait(5), seen )\n"
+                    // a CallbackQueue's thread delivers in this interpreter; a pending call would run in the main one, so that's refused
+                    "import time\n"
+                    "seen = []\n"
+                    "m.feed( lambda x: seen.append( __import__('sys') is sys ), 2, False, 64, 1, 10 )\n"
+                    "t0 = time.time()\n"
+                    "while len(seen) < 10 and time.time() - t0 < 5: time.sleep( 0.001 )\n"
+                    "m.feed_close()\n"
+                    "try: m.feed( seen.append, 0, False, 64, 0, 0 )\n"
+                    "except RuntimeError as e: refused = str(e)\n"
+                    "fed = ( seen, 'main interpreter' in refused )\n", Py_file_input, sub_ns.p, sub_ns.p ) };
+                throw_if_pyerr(TRACE);
+
+                Object sub_module{ sub_ns["m"] };
+                test_assert( "...imports its own module",   true, ! sub_module.is( module ) );
+                test_assert( "...with its own instance",    true, module_test_funcmapper::instance( sub_module ) != nullptr
+                                                                  && module_test_funcmapper::instance( sub_module ) != main_instance );
+                test_assert( "...and its own types",        true, ExtObject<new_style_class>::table() != main_type
+                                                                  && (PyObject*)ExtObject<new_style_class>::table() == Object{ sub_module.getAttr( "new_style_class"_py ) }.p );
+                test_assert( "...which work",               true, Object{ sub_ns["r"] }.p != nullptr
+                                                                  && PyObject_RichCompareBool( Object{ sub_ns["r"] }.p,
+                                                                         Object{ PyRun_String( "(42.0, 6.0, 'new_style_class', '1,0,red,2.000000', 'int 3', 'float')", Py_eval_input, sub_ns.p, sub_ns.p ) }.p, Py_EQ ) == 1 );
+                test_assert( "...offloads, finishing in it",    true, PyObject_RichCompareBool( Object{ sub_ns["offloaded"] }.p,
+                                                                  Object{ Py_BuildValue( "(OO[O])", Py_None, Py_True, Py_True ) }.p, Py_EQ ) == 1 );
+                test_assert( "...has its events delivered in it", true, static_cast<bool>( Object{ PyRun_String( "fed == ( [True] * 10, True )", Py_eval_input, sub_ns.p, sub_ns.p ) } ) );
+            }
+            test_assert( "...and its own interned literal", true, "alpha"_py.name().is( Object{ PyUnicode_InternFromString("alpha") } ) );
+            Py_EndInterpreter( sub );
+            PyThreadState_Swap( main_state );
+            test_assert( "main interpreter's literal again", true, "alpha"_py.name().is( main_alpha ) );
+            test_assert( "main interpreter's type again", true, ExtObject<new_style_class>::table() == main_type );
+            test_assert( "...and its module still works", 5.0, static_cast<double>( module.call_method( "twice"_py, 2.5 ) ) );
+
+            // an interpreter pool: a process per worker
+            {
+                auto error_of = []( std::future<std::string> f ) {
+                    try             { f.get(); }
+                    catch( const Exception& e ) { return e.message(); }
+                    return std::string{ "no error" };
+                };
+                auto has = []( const std::string& s, const char* part ) { return s.find( part ) != std::string::npos; };
+
+                InterpreterPool pool{ 2, { "test_funcmapper" } };
+                test_assert( "pool: as many workers as asked for",  size_t{2}, pool.size() );
+
+                std::vector< std::future<std::string> > results;
+                for( int i=0; i < 6; i++ )
+                    results.push_back( pool.submit( "x = test_funcmapper.twice( " + std::to_string(i) + " )", "x" ) );
+                std::string all;
+                for( auto& r : results )
+                    all += r.get() + " ";
+                test_assert( "...runs each script, with the module",    std::string{"0.0 2.0 4.0 6.0 8.0 10.0 "}, all );
+
+                std::future<std::string> set = pool.submit( "y = 1" );
+                test_assert( "...no expression, no result",     std::string{""},        set.get() );
+                test_assert( "...fresh globals each time",      std::string{"False"},   pool.submit( "", "'y' in globals()" ).get() );
+                test_assert( "...in another process",          true, pool.submit( "import os", "os.getpid()" ).get() != std::to_string( getpid() ) );
+                test_assert( "...a script's error",             true, has( error_of( pool.submit( "1/0" ) ), "ZeroDivisionError: division by zero" ) );
+                test_assert( "...a file that isn't there",      true, has( error_of( pool.submit_file( "./py/no_such_script.py" ) ), "can't read" ) );
+                test_assert( "...a file",                       std::string{"Derived"}, pool.submit_file( "./py/test_funcmapper.py", "type(d).__name__" ).get() );
+
+                InterpreterPool small{ 1, {}, 256 };
+                test_assert( "small buffer: script too big",    true, has( error_of( small.submit( std::string( 300, '#' ) ) ), "more than the pool's buffer" ) );
+                test_assert( "...result too big",               true, has( error_of( small.submit( "", "'x' * 1000" ) ), "more than the pool's buffer" ) );
+                test_assert( "...still working",                std::string{"42"}, small.submit( "", "6 * 7" ).get() );
+                test_assert( "worker dies with its script",     true, has( error_of( small.submit( "import os\nos._exit(3)" ) ), "died" ) );
+                test_assert( "...then no workers left",         true, has( error_of( small.submit( "", "1" ) ), "no workers left" ) );
+            }
+        }
+
         Py_Finalize();
     }
 }
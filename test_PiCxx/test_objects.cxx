@@ -28,6 +28,7 @@
  */
 
 #include "Objects.hxx"
+#include "test_assert.hxx"
 
 using namespace Py;
 
@@ -114,7 +115,7 @@ void test_ob() {
         XCOUT( Object( 'L', 1, 2.01, "three")[1] ); // list, second item
 
         Object dict( 'D',  "k1", 1.1,  "k2", 666 ); // dict
-        XCOUT( dict["k2"].str() ); // dict lookup, .str() illustrates that dict["k2"] is an object
+        XCOUT( dict["k2"]->str() ); // dict lookup: -> reads the item, then it is an Object
 
         XCOUT( Object( 'D',  "k1", 1.1,  "k2", 666 )["k2"] ); // could have just done it in one line...
 
@@ -152,6 +153,236 @@ void test_ob() {
                 auto&& leaves i mutable
                 auto& can't bind to an rvalue
              */
+
+        // Object is a bare PyObject*; the container/key needed for 'list[1] = ...' live in ItemProxy
+        test_assert( "sizeof(Object)", sizeof(PyObject*), sizeof(Object) );
+        {
+            Object d( 'D', "k1", 1 );
+            d["k2"] = d["k1"];                      // proxy = proxy assigns the value, not the proxy
+            test_assert( "proxy write-through", 1, static_cast<int>( d["k2"] ) );
+            test_assert( "missing key reads None", true, d["nope"]->isNone() );
+
+            Object l( 'L', 10, 20, 30 );
+            test_assert( "list[-1]", 30, static_cast<int>( l[-1] ) );
+            test_assert( "list out of range reads None", true, l[99]->isNone() );
+            Object huge{ PyLong_FromString( "100000000000000000000000", nullptr, 10 ) };
+            test_assert( "list[10**23] reads None",      true, l[huge]->isNone() );
+            test_assert( "...leaving no error",          true, PyErr_Occurred() == nullptr );
+
+            d["fresh"] = 2;                         // write to a missing key must not leave an error behind
+            test_assert( "no pending error after insert", true, PyErr_Occurred() == nullptr );
+
+            // a write doesn't read first: this mapping counts its __getitem__ calls
+            Object g{ PyDict_New() };
+            PyDict_SetItemString( g.p, "__builtins__", PyEval_GetBuiltins() );
+            Object ran{ PyRun_String( "class M(dict):\n"
+                                      "    reads = 0\n"
+                                      "    def __getitem__(self, k):\n"
+                                      "        M.reads += 1\n"
+                                      "        return dict.__getitem__(self, k)\n"
+                                      "m = M()\n", Py_file_input, g.p, g.p ) };
+            Object m{ charge( PyDict_GetItemString( g.p, "m" ) ) };
+            m["a"] = 1;
+            m["b"] = m["a"];
+            test_assert( "writes don't read",               1L, static_cast<long>( m.getAttr( "reads" ) ) );
+            test_assert( "...the value is read when used",  1,  static_cast<int>( m["b"] ) );
+            test_assert( "...once",                         2L, static_cast<long>( m.getAttr( "reads" ) ) );
+
+            // an error that was already pending is not swallowed by the read
+            PyErr_SetString( PyExc_RuntimeError, "pending" );
+            bool thrown = false;
+            try { Object x = d["k1"]; }
+            catch( const Exception& ) { thrown = true; }
+            test_assert( "a pending error is thrown, not cleared", true, thrown );
+            PyErr_Clear();
+
+            // 'auto x = d["k"]' is a proxy: assigning to it would write into d, so it doesn't compile
+            static_assert( ! std::is_assignable< ItemProxy&, Object >::value,  "an lvalue proxy must not be assignable" );
+            static_assert(   std::is_assignable< ItemProxy&&, Object >::value, "d[k] = v" );
+        }
+
+        // Moves, release/steal and Borrowed must not generate any INCREF/DECREF traffic
+        // (ref_traffic() counts every charge/discharge πcxx makes in debug builds)
+        {
+            Object a{ 1000*1000 }, b{ 2000*1000 };
+            ref_traffic().reset();
+
+            Object c = a + b;                       // operands go to PyNumber_Add by reference
+            bool lt = a < b;                        // ditto PyObject_RichCompareBool
+            Object d = std::move(c);                // move construct
+            c = std::move(d);                       // move assign (into the moved-from c)
+            Object e = Object::steal( c.release() );
+            Borrowed borrowed{ *e };                // non-owning view of a neutral pointer
+            const Object& view = borrowed;
+            test_assert( "borrowed view", e.ptr(), view.ptr() );
+
+            test_assert( "comparison result", true, lt );
+            test_assert( "charges on hot path", 0L, ref_traffic().charges );
+            test_assert( "discharges on hot path", 0L, ref_traffic().discharges );
+            test_assert( "moved-from is null", true, d.isNull() );
+        }
+
+        // variadic builders allocate the container at its final size and fill it in place
+        {
+            Object a{ 1000*1000 };
+            ref_traffic().reset();
+            Object t( 'T', a, std::move(a) );       // one charge for the copied Object, none for the moved one
+            test_assert( "tuple build charges", 1L, ref_traffic().charges );
+            test_assert( "tuple size", 2L, static_cast<long>( t.size() ) );
+
+            test_assert( "empty dict", true, Object{ 'D' }.isDict() );
+            test_assert( "presized dict", 2L, static_cast<long>( Object( 'D', 1, 2, 3, 4 ).size() ) );
+            test_assert( "set dedups", 2L, static_cast<long>( Object( 'S', 1, 1, 2 ).size() ) );
+
+            bool threw = false;
+            try { Object( 'D', 1, 2, 3 ); }
+            catch( const Exception& ) { threw = true; }
+            test_assert( "odd dict arguments throw", true, threw );
+        }
+
+        // begin()/end() pick the iteration strategy from the container's exact type
+        {
+            Object l( 'L', 1, 2, 3, 4 );
+            long sum = 0;
+            ref_traffic().reset();
+            for( const Object& i : l )              // items borrowed in place: no boxing, no refcount traffic
+                sum += static_cast<long>( PyLong_AsLong(*i) );
+            test_assert( "list sum", 10L, sum );
+            test_assert( "list iteration charges", 0L, ref_traffic().charges );
+
+            auto seq = Object( 'T', 5, 6, 7 ).as_sequence();
+            test_assert( "as_sequence random access", 3L, static_cast<long>( seq.end() - seq.begin() ) );
+            test_assert( "as_sequence[2]", 7, static_cast<int>( seq[2] ) );
+            test_assert( "as_sequence from set", 2L, static_cast<long>( Object( 'S', 8, 9 ).as_sequence().size() ) );
+
+            // begin()/end() may be walking a one-shot Python iterator: multi-pass algorithms must not accept it
+            static_assert( std::is_same< std::iterator_traits<Object::iterator>::iterator_category, std::input_iterator_tag >::value,
+                           "Object::iterator is single-pass" );
+            static_assert( std::is_same< std::iterator_traits<SequenceRange::iterator>::iterator_category, std::random_access_iterator_tag >::value,
+                           "as_sequence() is random-access" );
+
+            Object d( 'D', "a", 1, "b", 2 );
+            std::string keys;
+            for( const Object& k : d )              // a dict iterates its keys, as in Python
+                keys += k.as_string();
+            test_assert( "dict keys", std::string{"ab"}, keys );
+
+            long vsum = 0;
+            for( const Object& v : d.iter_values() )
+                vsum += static_cast<long>(v);
+            test_assert( "dict values", 3L, vsum );
+
+            std::string items;
+            for( auto kv : d.iter_items() )
+                items += kv.first.as_string() + kv.second.as_string();
+            test_assert( "dict items", std::string{"a1b2"}, items );
+
+            long n = 0;
+            for( const Object& i : Object( 'S', 1, 2, 3 ) )   // generic: PyObject_GetIter
+                n += static_cast<long>(i);
+            test_assert( "set via PyObject_GetIter", 6L, n );
+        }
+
+        // call / call_method go through vectorcall: no args tuple, keywords by name
+        {
+            Borrowed int_type_view{ (PyObject*)&PyLong_Type };
+            const Object& int_type = int_type_view;
+            test_assert( "call with keyword", 255L, static_cast<long>( int_type.call( "ff", kw("base", 16) ) ) );
+            test_assert( "call_method", 2L, static_cast<long>( Object{"a,b"}.call_method( Object{"split"}, "," ).size() ) );
+            test_assert( "call_method with keyword", std::string{"x=5"},
+                         Object{"x={x}"}.call_method( Object{"format"}, kw("x", 5) ).as_string() );
+
+            bool threw = false;
+            try { int_type.call( "zz", kw("base", 10) ); }
+            catch( const Exception& ) { threw = true; PyErr_Clear(); }
+            test_assert( "call raises", true, threw );
+        }
+
+        // call_method through an AttrHandle: the name is interned, the lookup is Python's every time
+        {
+            Object g{ PyDict_New() };
+            PyDict_SetItemString( g.p, "__builtins__", PyEval_GetBuiltins() );
+            Object ran{ PyRun_String( "class K:\n    def m(self, a): return a + 1\nk = K()\n", Py_file_input, g.p, g.p ) };
+            Object k{ g["k"] };
+
+            AttrHandle m{ "m" };
+            test_assert( "handle call", 2L, static_cast<long>( k.call_method( m, 1 ) ) );
+            test_assert( "handle call again", 3L, static_cast<long>( k.call_method( m, 2 ) ) );
+
+            Object ran2{ PyRun_String( "K.m = lambda self, a: a * 10\n", Py_file_input, g.p, g.p ) };
+            test_assert( "type changed", 20L, static_cast<long>( k.call_method( m, 2 ) ) );
+
+            Object ran3{ PyRun_String( "k.m = lambda a: -a\n", Py_file_input, g.p, g.p ) };
+            test_assert( "instance shadows", -2L, static_cast<long>( k.call_method( m, 2 ) ) );
+
+            AttrHandle split{ "split" };
+            test_assert( "handle on builtin type", 3L, static_cast<long>( Object{"a b c"}.call_method( split ).size() ) );
+
+            AttrHandle upper{ "upper" };
+            test_assert( "AttrHandle", true, Object{"x"}.hasAttr( upper ) && Object{"x"}.getAttr( upper ).isCallable() );
+        }
+
+        // "name"_py: one interned str per literal, usable wherever a key or attribute name goes
+        {
+            const Interned& a = "alpha"_py;
+            test_assert( "literal is interned", true, a.name().is( Object{ PyUnicode_InternFromString("alpha") } ) );
+
+            Object d{ 'D' };
+            d[ "alpha"_py ] = 1;
+            test_assert( "dict read by literal", 1L, static_cast<long>( d[ "alpha"_py ] ) );
+            test_assert( "dict holds the interned key itself", true, ( *d.begin() ).is( "alpha"_py ) );
+
+            Object ns{ PyImport_ImportModule("types") };
+            Object obj{ ns.getAttr( "SimpleNamespace"_py ).call() };
+            obj.setAttr( "beta"_py, 2 );
+            test_assert( "setAttr/getAttr by literal", 2L, static_cast<long>( obj.getAttr( "beta"_py ) ) );
+            obj.delAttr( "beta"_py );
+            test_assert( "delAttr by literal", false, obj.hasAttr( "beta"_py ) );
+        }
+
+        // strings are read in place: std::string(ob) makes one copy, as_string_view() none
+        {
+            Object s{ "h\xc3\xa9llo" };                // 'héllo'
+            test_assert( "std::string from str", std::string{"h\xc3\xa9llo"}, static_cast<std::string>(s) );
+            test_assert( "string_view of str", std::string{"h\xc3\xa9llo"}, std::string{ s.as_string_view() } );
+            test_assert( "string_view is in place", true, s.as_string_view().data() == s.as_string_view().data() );
+
+            Object b{ PyBytes_FromStringAndSize( "a\0b", 3 ) };
+            test_assert( "bytes keep embedded NUL", 3L, static_cast<long>( static_cast<std::string>(b).size() ) );
+            test_assert( "string_view of bytes", 3L, static_cast<long>( b.as_string_view().size() ) );
+
+            bool threw = false;
+            try { Object{ 42 }.as_string_view(); }
+            catch( const Exception& ) { threw = true; }
+            test_assert( "string_view of int throws", true, threw );
+            test_assert( "std::string from int still converts", std::string{"42"}, static_cast<std::string>( Object{ 42 } ) );
+        }
+
+        // numeric conversions read exact int/float directly, and refuse to truncate
+        {
+            test_assert( "int -> long",          42L,  static_cast<long>( Object{ 42 } ) );
+            test_assert( "str -> int converts",  42,   static_cast<int>( Object{ "42" } ) );
+            test_assert( "float -> double",      2.5,  static_cast<double>( Object{ 2.5 } ) );
+            test_assert( "int -> double",        3.0,  static_cast<double>( Object{ 3 } ) );
+            test_assert( "True -> int",          1,    static_cast<int>( True() ) );
+            test_assert( "nonzero -> bool",      true, static_cast<bool>( Object{ 7 } ) );
+
+            bool threw = false;
+            try { static_cast<uint8_t>( Object{ 300 } ); }
+            catch( const Exception& ) { threw = true; PyErr_Clear(); }
+            test_assert( "300 -> uint8_t overflows", true, threw );
+
+            threw = false;
+            try { static_cast<unsigned>( Object{ -1 } ); }
+            catch( const Exception& ) { threw = true; PyErr_Clear(); }
+            test_assert( "-1 -> unsigned overflows", true, threw );
+
+            test_assert( "try_as ok",            true,  Object{ 5 }.try_as<short>() == std::optional<short>{5} );
+            test_assert( "try_as overflow",      false, Object{ 1L << 40 }.try_as<int>().has_value() );
+            test_assert( "try_as wrong type",    false, Object{ "x" }.try_as<double>().has_value() );
+            test_assert( "try_as leaves no error", true, PyErr_Occurred() == nullptr );
+            test_assert( "try_as float narrow",  false, Object{ 1e300 }.try_as<float>().has_value() );
+        }
     }
 
     Py_Finalize();